@@ -2307,51 +2307,55 @@ NTSTATUS WINAPI BCryptDeriveKeyCapi( BCRYPT_HASH_HANDLE handle, BCRYPT_ALG_HANDL
     return STATUS_SUCCESS;
 }
 
+/* finish a PBKDF2 round, starting from copies of the prepared states so that they can be reused */
+static NTSTATUS pbkdf2_finish( const struct hash *hash, struct hash_impl *inner, UCHAR *dst, ULONG hash_len )
+{
+    struct hash_impl outer;
+    NTSTATUS status;
+
+    if ((status = hash_finish( inner, hash->alg_id, dst ))) return status;
+    if (!(hash->flags & HASH_FLAG_HMAC)) return STATUS_SUCCESS;
+
+    outer = hash->outer;
+    if ((status = hash_update( &outer, hash->alg_id, dst, hash_len ))) return status;
+    return hash_finish( &outer, hash->alg_id, dst );
+}
+
 static NTSTATUS pbkdf2( struct hash *hash, UCHAR *pwd, ULONG pwd_len, UCHAR *salt, ULONG salt_len,
                         ULONGLONG iterations, ULONG i, UCHAR *dst, ULONG hash_len )
 {
-    NTSTATUS status = STATUS_INVALID_PARAMETER;
-    UCHAR bytes[4], *buf;
-    ULONG j, k;
+    UCHAR bytes[4], buf[MAX_HASH_OUTPUT_BYTES];
+    struct hash_impl inner;
+    NTSTATUS status;
+    ULONGLONG j;
+    ULONG k;
 
-    if (!(buf = malloc( hash_len ))) return STATUS_NO_MEMORY;
+    if (!iterations) return STATUS_INVALID_PARAMETER;
 
-    for (j = 0; j < iterations; j++)
-    {
-        if (j == 0)
-        {
-            /* use salt || INT(i) */
-            if ((status = hash_update( &hash->inner, hash->alg_id, salt, salt_len )))
-            {
-                free( buf );
-                return status;
-            }
-            bytes[0] = (i >> 24) & 0xff;
-            bytes[1] = (i >> 16) & 0xff;
-            bytes[2] = (i >> 8) & 0xff;
-            bytes[3] = i & 0xff;
-            status = hash_update( &hash->inner, hash->alg_id, bytes, 4 );
-        }
-        else status = hash_update( &hash->inner, hash->alg_id, buf, hash_len ); /* use U_j */
+    /* The key is only processed once, hash->inner and hash->outer hold the states after
+     * hashing the padded key and each round starts from a copy of them. */
 
-        if (status)
-        {
-            free( buf );
-            return status;
-        }
+    /* U_1 = PRF(salt || INT(i)) */
+    inner = hash->inner;
+    bytes[0] = (i >> 24) & 0xff;
+    bytes[1] = (i >> 16) & 0xff;
+    bytes[2] = (i >> 8) & 0xff;
+    bytes[3] = i & 0xff;
+    if ((status = hash_update( &inner, hash->alg_id, salt, salt_len )) ||
+        (status = hash_update( &inner, hash->alg_id, bytes, 4 )) ||
+        (status = pbkdf2_finish( hash, &inner, buf, hash_len ))) return status;
+    memcpy( dst, buf, hash_len );
 
-        if ((status = hash_finalize( hash, buf )))
-        {
-            free( buf );
-            return status;
-        }
-
-        if (j == 0) memcpy( dst, buf, hash_len );
-        else for (k = 0; k < hash_len; k++) dst[k] ^= buf[k];
+    /* U_j = PRF(U_{j-1}) */
+    for (j = 1; j < iterations; j++)
+    {
+        inner = hash->inner;
+        if ((status = hash_update( &inner, hash->alg_id, buf, hash_len )) ||
+            (status = pbkdf2_finish( hash, &inner, buf, hash_len ))) return status;
+        for (k = 0; k < hash_len; k++) dst[k] ^= buf[k];
     }
 
-    free( buf );
-    return status;
+    return STATUS_SUCCESS;
 }
 
 static NTSTATUS derive_key_pbkdf2( struct algorithm *alg, UCHAR *pwd, ULONG pwd_len, UCHAR *salt, ULONG salt_len,
@@ -588,6 +588,24 @@ HRESULT d2d_geometry_group_init(struct d2d_geometry *geometry, ID2D1Factory *fac
         D2D1_FILL_MODE fill_mode, ID2D1Geometry **src_geometries, unsigned int geometry_count) DECLSPEC_HIDDEN;
 struct d2d_geometry *unsafe_impl_from_ID2D1Geometry(ID2D1Geometry *iface) DECLSPEC_HIDDEN;
 
+struct d2d_geometry_realization
+{
+    ID2D1GeometryRealization ID2D1GeometryRealization_iface;
+    LONG refcount;
+
+    ID2D1Factory *factory;
+    ID2D1Geometry *geometry;
+    BOOL filled;
+    float stroke_width;
+    ID2D1StrokeStyle *stroke_style;
+};
+
+HRESULT d2d_geometry_realization_create(ID2D1Factory *factory, ID2D1Geometry *geometry, BOOL filled,
+        float stroke_width, ID2D1StrokeStyle *stroke_style,
+        struct d2d_geometry_realization **realization) DECLSPEC_HIDDEN;
+struct d2d_geometry_realization *unsafe_impl_from_ID2D1GeometryRealization(
+        ID2D1GeometryRealization *iface) DECLSPEC_HIDDEN;
+
 struct d2d_device
 {
     ID2D1Device1 ID2D1Device1_iface;
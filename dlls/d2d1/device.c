@@ -2649,26 +2649,49 @@ static void STDMETHODCALLTYPE d2d_device_context_ID2D1DeviceContext_FillOpacityM
 static HRESULT STDMETHODCALLTYPE d2d_device_context_CreateFilledGeometryRealization(ID2D1DeviceContext1 *iface,
         ID2D1Geometry *geometry, float tolerance, ID2D1GeometryRealization **realization)
 {
-    FIXME("iface %p, geometry %p, tolerance %.8e, realization %p stub!\n", iface, geometry, tolerance,
+    struct d2d_device_context *context = impl_from_ID2D1DeviceContext(iface);
+    struct d2d_geometry_realization *object;
+    HRESULT hr;
+
+    TRACE("iface %p, geometry %p, tolerance %.8e, realization %p.\n", iface, geometry, tolerance,
             realization);
 
-    return E_NOTIMPL;
+    if (SUCCEEDED(hr = d2d_geometry_realization_create(context->factory, geometry, TRUE, 0.0f, NULL, &object)))
+        *realization = &object->ID2D1GeometryRealization_iface;
+
+    return hr;
 }
 
 static HRESULT STDMETHODCALLTYPE d2d_device_context_CreateStrokedGeometryRealization(ID2D1DeviceContext1 *iface,
         ID2D1Geometry *geometry, float tolerance, float stroke_width, ID2D1StrokeStyle *stroke_style,
         ID2D1GeometryRealization **realization)
 {
-    FIXME("iface %p, geometry %p, tolerance %.8e, stroke_width %.8e, stroke_style %p, realization %p stub!\n",
+    struct d2d_device_context *context = impl_from_ID2D1DeviceContext(iface);
+    struct d2d_geometry_realization *object;
+    HRESULT hr;
+
+    TRACE("iface %p, geometry %p, tolerance %.8e, stroke_width %.8e, stroke_style %p, realization %p.\n",
             iface, geometry, tolerance, stroke_width, stroke_style, realization);
 
-    return E_NOTIMPL;
+    if (SUCCEEDED(hr = d2d_geometry_realization_create(context->factory, geometry, FALSE,
+            stroke_width, stroke_style, &object)))
+        *realization = &object->ID2D1GeometryRealization_iface;
+
+    return hr;
 }
 
 static void STDMETHODCALLTYPE d2d_device_context_DrawGeometryRealization(ID2D1DeviceContext1 *iface,
         ID2D1GeometryRealization *realization, ID2D1Brush *brush)
 {
-    FIXME("iface %p, realization %p, brush %p stub!\n", iface, realization, brush);
+    struct d2d_geometry_realization *realization_impl = unsafe_impl_from_ID2D1GeometryRealization(realization);
+
+    TRACE("iface %p, realization %p, brush %p.\n", iface, realization, brush);
+
+    if (realization_impl->filled)
+        d2d_device_context_FillGeometry(iface, realization_impl->geometry, brush, NULL);
+    else
+        d2d_device_context_DrawGeometry(iface, realization_impl->geometry, brush,
+                realization_impl->stroke_width, realization_impl->stroke_style);
 }
 
 static const struct ID2D1DeviceContext1Vtbl d2d_device_context_vtbl =
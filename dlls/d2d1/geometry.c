@@ -123,6 +123,12 @@ struct d2d_geometry_intersections
     size_t intersection_count;
 };
 
+struct d2d_geometry_segment
+{
+    struct d2d_segment_idx idx;
+    D2D1_RECT_F bounds;
+};
+
 struct d2d_fp_two_vec2
 {
     float x[2];
@@ -2195,82 +2201,113 @@ static BOOL d2d_geometry_apply_intersections(struct d2d_geometry *geometry,
     return TRUE;
 }
 
-/* Intersect the geometry's segments with themselves. This uses the
- * straightforward approach of testing everything against everything, but
- * there certainly exist more scalable algorithms for this. */
+static int __cdecl d2d_geometry_segments_compare(const void *a, const void *b)
+{
+    const struct d2d_geometry_segment *s0 = a;
+    const struct d2d_geometry_segment *s1 = b;
+
+    if (s0->bounds.left != s1->bounds.left)
+        return s0->bounds.left > s1->bounds.left ? 1 : -1;
+    return 0;
+}
+
+static BOOL d2d_geometry_intersect_segments(struct d2d_geometry *geometry,
+        struct d2d_geometry_intersections *intersections, const struct d2d_segment_idx *idx_p,
+        const struct d2d_segment_idx *idx_q)
+{
+    enum d2d_vertex_type type_p, type_q;
+
+    type_p = geometry->u.path.figures[idx_p->figure_idx].vertex_types[idx_p->vertex_idx];
+    type_q = geometry->u.path.figures[idx_q->figure_idx].vertex_types[idx_q->vertex_idx];
+
+    if (d2d_vertex_type_is_bezier(type_q))
+    {
+        if (d2d_vertex_type_is_bezier(type_p))
+            return d2d_geometry_intersect_bezier_bezier(geometry, intersections,
+                    idx_p, 0.0f, 1.0f, idx_q, 0.0f, 1.0f);
+        return d2d_geometry_intersect_bezier_line(geometry, intersections, idx_q, idx_p);
+    }
+
+    if (d2d_vertex_type_is_bezier(type_p))
+        return d2d_geometry_intersect_bezier_line(geometry, intersections, idx_p, idx_q);
+    return d2d_geometry_intersect_line_line(geometry, intersections, idx_p, idx_q);
+}
+
+/* Intersect the geometry's segments with themselves. Segments are sorted by
+ * the left edge of their bounding boxes, and each segment is only tested
+ * against the segments that follow it for as long as their horizontal
+ * extents overlap. */
 static BOOL d2d_geometry_intersect_self(struct d2d_geometry *geometry)
 {
     struct d2d_geometry_intersections intersections = {0};
-    const struct d2d_figure *figure_p, *figure_q;
-    struct d2d_segment_idx idx_p, idx_q;
-    enum d2d_vertex_type type_p, type_q;
+    struct d2d_geometry_segment *segments, *p, *q;
+    size_t segment_count = 0, i, j, next;
+    const struct d2d_figure *figure;
+    struct d2d_segment_idx idx;
     BOOL ret = FALSE;
-    size_t max_q;
 
     if (!geometry->u.path.figure_count)
         return TRUE;
 
-    for (idx_p.figure_idx = 0; idx_p.figure_idx < geometry->u.path.figure_count; ++idx_p.figure_idx)
+    for (i = 0; i < geometry->u.path.figure_count; ++i)
+        segment_count += geometry->u.path.figures[i].vertex_count;
+    if (!segment_count)
+        return TRUE;
+    if (!(segments = calloc(segment_count, sizeof(*segments))))
+    {
+        ERR("Failed to allocate segments array.\n");
+        return FALSE;
+    }
+
+    segment_count = 0;
+    for (idx.figure_idx = 0; idx.figure_idx < geometry->u.path.figure_count; ++idx.figure_idx)
     {
-        figure_p = &geometry->u.path.figures[idx_p.figure_idx];
-        idx_p.control_idx = 0;
-        for (idx_p.vertex_idx = 0; idx_p.vertex_idx < figure_p->vertex_count; ++idx_p.vertex_idx)
+        figure = &geometry->u.path.figures[idx.figure_idx];
+        idx.control_idx = 0;
+        for (idx.vertex_idx = 0; idx.vertex_idx < figure->vertex_count; ++idx.vertex_idx)
         {
-            if ((type_p = figure_p->vertex_types[idx_p.vertex_idx]) == D2D_VERTEX_TYPE_END)
+            if (figure->vertex_types[idx.vertex_idx] == D2D_VERTEX_TYPE_END)
                 continue;
 
-            for (idx_q.figure_idx = 0; idx_q.figure_idx <= idx_p.figure_idx; ++idx_q.figure_idx)
-            {
-                figure_q = &geometry->u.path.figures[idx_q.figure_idx];
-                if (idx_q.figure_idx != idx_p.figure_idx)
-                {
-                    if (!d2d_rect_check_overlap(&figure_p->bounds, &figure_q->bounds))
-                        continue;
-                    if ((max_q = figure_q->vertex_count)
-                            && figure_q->vertex_types[max_q - 1] == D2D_VERTEX_TYPE_END)
-                        --max_q;
-                }
-                else
-                {
-                    max_q = idx_p.vertex_idx;
-                }
+            p = &segments[segment_count++];
+            p->idx = idx;
 
-                idx_q.control_idx = 0;
-                for (idx_q.vertex_idx = 0; idx_q.vertex_idx < max_q; ++idx_q.vertex_idx)
-                {
-                    type_q = figure_q->vertex_types[idx_q.vertex_idx];
-                    if (d2d_vertex_type_is_bezier(type_q))
-                    {
-                        if (d2d_vertex_type_is_bezier(type_p))
-                        {
-                            if (!d2d_geometry_intersect_bezier_bezier(geometry, &intersections,
-                                    &idx_p, 0.0f, 1.0f, &idx_q, 0.0f, 1.0f))
-                                goto done;
-                        }
-                        else
-                        {
-                            if (!d2d_geometry_intersect_bezier_line(geometry, &intersections, &idx_q, &idx_p))
-                                goto done;
-                        }
-                        ++idx_q.control_idx;
-                    }
-                    else
-                    {
-                        if (d2d_vertex_type_is_bezier(type_p))
-                        {
-                            if (!d2d_geometry_intersect_bezier_line(geometry, &intersections, &idx_p, &idx_q))
-                                goto done;
-                        }
-                        else
-                        {
-                            if (!d2d_geometry_intersect_line_line(geometry, &intersections, &idx_p, &idx_q))
-                                goto done;
-                        }
-                    }
-                }
+            next = idx.vertex_idx + 1;
+            if (next == figure->vertex_count)
+                next = 0;
+            p->bounds.left = p->bounds.right = figure->vertices[idx.vertex_idx].x;
+            p->bounds.top = p->bounds.bottom = figure->vertices[idx.vertex_idx].y;
+            d2d_rect_expand(&p->bounds, &figure->vertices[next]);
+
+            /* The control point hull contains the whole curve. */
+            if (d2d_vertex_type_is_bezier(figure->vertex_types[idx.vertex_idx]))
+                d2d_rect_expand(&p->bounds, &figure->bezier_controls[idx.control_idx++]);
+        }
+    }
+
+    qsort(segments, segment_count, sizeof(*segments), d2d_geometry_segments_compare);
+
+    for (i = 0; i < segment_count; ++i)
+    {
+        for (j = i + 1; j < segment_count && segments[j].bounds.left <= segments[i].bounds.right; ++j)
+        {
+            if (segments[j].bounds.top > segments[i].bounds.bottom
+                    || segments[j].bounds.bottom < segments[i].bounds.top)
+                continue;
+
+            /* Keep the argument order of the exhaustive search, the later
+             * segment goes first. */
+            p = &segments[i];
+            q = &segments[j];
+            if (p->idx.figure_idx < q->idx.figure_idx || (p->idx.figure_idx == q->idx.figure_idx
+                    && p->idx.vertex_idx < q->idx.vertex_idx))
+            {
+                p = &segments[j];
+                q = &segments[i];
             }
-            if (d2d_vertex_type_is_bezier(type_p))
-                ++idx_p.control_idx;
+
+            if (!d2d_geometry_intersect_segments(geometry, &intersections, &p->idx, &q->idx))
+                goto done;
         }
     }
 
@@ -2280,6 +2317,7 @@ static BOOL d2d_geometry_intersect_self(struct d2d_geometry *geometry)
 
 done:
     free(intersections.intersections);
+    free(segments);
     return ret;
 }
 
@@ -5516,3 +5554,105 @@ struct d2d_geometry *unsafe_impl_from_ID2D1Geometry(ID2D1Geometry *iface)
             || iface->lpVtbl == (const ID2D1GeometryVtbl *)&d2d_geometry_group_vtbl);
     return CONTAINING_RECORD(iface, struct d2d_geometry, ID2D1Geometry_iface);
 }
+
+static inline struct d2d_geometry_realization *impl_from_ID2D1GeometryRealization(ID2D1GeometryRealization *iface)
+{
+    return CONTAINING_RECORD(iface, struct d2d_geometry_realization, ID2D1GeometryRealization_iface);
+}
+
+static HRESULT STDMETHODCALLTYPE d2d_geometry_realization_QueryInterface(ID2D1GeometryRealization *iface,
+        REFIID iid, void **out)
+{
+    TRACE("iface %p, iid %s, out %p.\n", iface, debugstr_guid(iid), out);
+
+    if (IsEqualGUID(iid, &IID_ID2D1GeometryRealization)
+            || IsEqualGUID(iid, &IID_ID2D1Resource)
+            || IsEqualGUID(iid, &IID_IUnknown))
+    {
+        ID2D1GeometryRealization_AddRef(iface);
+        *out = iface;
+        return S_OK;
+    }
+
+    WARN("%s not implemented, returning E_NOINTERFACE.\n", debugstr_guid(iid));
+
+    *out = NULL;
+    return E_NOINTERFACE;
+}
+
+static ULONG STDMETHODCALLTYPE d2d_geometry_realization_AddRef(ID2D1GeometryRealization *iface)
+{
+    struct d2d_geometry_realization *realization = impl_from_ID2D1GeometryRealization(iface);
+    ULONG refcount = InterlockedIncrement(&realization->refcount);
+
+    TRACE("%p increasing refcount to %lu.\n", iface, refcount);
+
+    return refcount;
+}
+
+static ULONG STDMETHODCALLTYPE d2d_geometry_realization_Release(ID2D1GeometryRealization *iface)
+{
+    struct d2d_geometry_realization *realization = impl_from_ID2D1GeometryRealization(iface);
+    ULONG refcount = InterlockedDecrement(&realization->refcount);
+
+    TRACE("%p decreasing refcount to %lu.\n", iface, refcount);
+
+    if (!refcount)
+    {
+        if (realization->stroke_style)
+            ID2D1StrokeStyle_Release(realization->stroke_style);
+        ID2D1Geometry_Release(realization->geometry);
+        ID2D1Factory_Release(realization->factory);
+        free(realization);
+    }
+
+    return refcount;
+}
+
+static void STDMETHODCALLTYPE d2d_geometry_realization_GetFactory(ID2D1GeometryRealization *iface,
+        ID2D1Factory **factory)
+{
+    struct d2d_geometry_realization *realization = impl_from_ID2D1GeometryRealization(iface);
+
+    TRACE("iface %p, factory %p.\n", iface, factory);
+
+    ID2D1Factory_AddRef(*factory = realization->factory);
+}
+
+static const struct ID2D1GeometryRealizationVtbl d2d_geometry_realization_vtbl =
+{
+    d2d_geometry_realization_QueryInterface,
+    d2d_geometry_realization_AddRef,
+    d2d_geometry_realization_Release,
+    d2d_geometry_realization_GetFactory,
+};
+
+/* Fill and outline tessellation is done once, when the geometry is created or
+ * its sink is closed, so keeping a reference to the source geometry is enough
+ * to reuse it for every DrawGeometryRealization() call. */
+HRESULT d2d_geometry_realization_create(ID2D1Factory *factory, ID2D1Geometry *geometry, BOOL filled,
+        float stroke_width, ID2D1StrokeStyle *stroke_style, struct d2d_geometry_realization **realization)
+{
+    if (!(*realization = calloc(1, sizeof(**realization))))
+        return E_OUTOFMEMORY;
+
+    (*realization)->ID2D1GeometryRealization_iface.lpVtbl = &d2d_geometry_realization_vtbl;
+    (*realization)->refcount = 1;
+    ID2D1Factory_AddRef((*realization)->factory = factory);
+    ID2D1Geometry_AddRef((*realization)->geometry = geometry);
+    (*realization)->filled = filled;
+    (*realization)->stroke_width = stroke_width;
+    if (((*realization)->stroke_style = stroke_style))
+        ID2D1StrokeStyle_AddRef(stroke_style);
+
+    TRACE("Created geometry realization %p.\n", *realization);
+    return S_OK;
+}
+
+struct d2d_geometry_realization *unsafe_impl_from_ID2D1GeometryRealization(ID2D1GeometryRealization *iface)
+{
+    if (!iface)
+        return NULL;
+    assert(iface->lpVtbl == &d2d_geometry_realization_vtbl);
+    return CONTAINING_RECORD(iface, struct d2d_geometry_realization, ID2D1GeometryRealization_iface);
+}
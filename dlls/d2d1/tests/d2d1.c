@@ -13356,6 +13356,79 @@ static void test_bitmap_create(BOOL d3d11)
     release_test_context(&ctx);
 }
 
+static void test_geometry_realization(BOOL d3d11)
+{
+    ID2D1GeometryRealization *filled, *stroked;
+    ID2D1DeviceContext1 *context1;
+    struct d2d1_test_context ctx;
+    struct resource_readback rb;
+    D2D1_MATRIX_3X2_F matrix;
+    ID2D1SolidColorBrush *brush;
+    ID2D1Factory *factory;
+    ID2D1Geometry *geometry;
+    D2D1_COLOR_F color;
+    D2D1_RECT_F rect;
+    DWORD colour;
+    HRESULT hr;
+
+    if (!init_test_context(&ctx, d3d11))
+        return;
+
+    hr = ID2D1DeviceContext_QueryInterface(ctx.context, &IID_ID2D1DeviceContext1, (void **)&context1);
+    if (FAILED(hr))
+    {
+        win_skip("ID2D1DeviceContext1 is not supported.\n");
+        release_test_context(&ctx);
+        return;
+    }
+
+    set_rect(&rect, 10.0f, 10.0f, 50.0f, 50.0f);
+    hr = ID2D1Factory_CreateRectangleGeometry(ctx.factory, &rect, (ID2D1RectangleGeometry **)&geometry);
+    ok(hr == S_OK, "Got unexpected hr %#lx.\n", hr);
+
+    hr = ID2D1DeviceContext1_CreateFilledGeometryRealization(context1, geometry, 0.25f, &filled);
+    ok(hr == S_OK, "Got unexpected hr %#lx.\n", hr);
+    ID2D1GeometryRealization_GetFactory(filled, &factory);
+    ok(factory == ctx.factory, "Got unexpected factory %p, expected %p.\n", factory, ctx.factory);
+    ID2D1Factory_Release(factory);
+
+    hr = ID2D1DeviceContext1_CreateStrokedGeometryRealization(context1, geometry, 0.25f, 4.0f, NULL, &stroked);
+    ok(hr == S_OK, "Got unexpected hr %#lx.\n", hr);
+    ID2D1Geometry_Release(geometry);
+
+    set_color(&color, 1.0f, 0.0f, 0.0f, 1.0f);
+    hr = ID2D1DeviceContext1_CreateSolidColorBrush(context1, &color, NULL, &brush);
+    ok(hr == S_OK, "Got unexpected hr %#lx.\n", hr);
+
+    ID2D1DeviceContext1_BeginDraw(context1);
+    set_color(&color, 1.0f, 1.0f, 1.0f, 1.0f);
+    ID2D1DeviceContext1_Clear(context1, &color);
+    ID2D1DeviceContext1_DrawGeometryRealization(context1, filled, (ID2D1Brush *)brush);
+    set_color(&color, 0.0f, 1.0f, 0.0f, 1.0f);
+    ID2D1SolidColorBrush_SetColor(brush, &color);
+    set_matrix_identity(&matrix);
+    translate_matrix(&matrix, 60.0f, 0.0f);
+    ID2D1DeviceContext1_SetTransform(context1, &matrix);
+    ID2D1DeviceContext1_DrawGeometryRealization(context1, stroked, (ID2D1Brush *)brush);
+    hr = ID2D1DeviceContext1_EndDraw(context1, NULL, NULL);
+    ok(hr == S_OK, "Got unexpected hr %#lx.\n", hr);
+
+    get_surface_readback(&ctx, &rb);
+    colour = get_readback_colour(&rb, 30, 30);
+    ok(colour == 0xffff0000, "Got unexpected colour %08lx.\n", colour);
+    colour = get_readback_colour(&rb, 70, 30);
+    ok(colour == 0xff00ff00, "Got unexpected colour %08lx.\n", colour);
+    colour = get_readback_colour(&rb, 90, 30);
+    ok(colour == 0xffffffff, "Got unexpected colour %08lx.\n", colour);
+    release_resource_readback(&rb);
+
+    ID2D1SolidColorBrush_Release(brush);
+    ID2D1GeometryRealization_Release(stroked);
+    ID2D1GeometryRealization_Release(filled);
+    ID2D1DeviceContext1_Release(context1);
+    release_test_context(&ctx);
+}
+
 START_TEST(d2d1)
 {
     HMODULE d2d1_dll = GetModuleHandleA("d2d1.dll");
@@ -13440,6 +13513,7 @@ START_TEST(d2d1)
     queue_test(test_image_bounds);
     queue_test(test_bitmap_map);
     queue_test(test_bitmap_create);
+    queue_test(test_geometry_realization);
 
     run_queued_tests();
 }
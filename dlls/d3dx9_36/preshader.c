@@ -1610,10 +1610,11 @@ static double exec_get_arg(struct d3dx_regstore *rs, const struct d3dx_pres_oper
 
     table = opr->reg.table;
 
+    /* Non-relative operands are bounds checked once in parse_preshader(). */
     if (opr->index_reg.table == PRES_REGTAB_COUNT)
-        base_index = 0;
-    else
-        base_index = lrint(exec_get_reg_value(rs, opr->index_reg.table, opr->index_reg.offset));
+        return exec_get_reg_value(rs, table, opr->reg.offset + comp);
+
+    base_index = lrint(exec_get_reg_value(rs, opr->index_reg.table, opr->index_reg.offset));
 
     offset = get_offset_reg(table, base_index) + opr->reg.offset + comp;
     reg_index = get_reg_offset(table, offset);
@@ -1652,6 +1653,20 @@ static void exec_set_arg(struct d3dx_regstore *rs, const struct d3dx_pres_reg *r
     regstore_set_double(rs, reg->table, reg->offset + comp, res);
 }
 
+static double exec_op(const struct op_info *oi, enum pres_ops op, double *args, int n)
+{
+    /* The most frequent operations are cheap enough for the indirect call to
+     * dominate their cost, dispatch those inline. */
+    switch (op)
+    {
+        case PRESHADER_OP_MOV: return args[0];
+        case PRESHADER_OP_NEG: return -args[0];
+        case PRESHADER_OP_ADD: return args[0] + args[1];
+        case PRESHADER_OP_MUL: return args[0] * args[1];
+        default: return oi->func(args, n);
+    }
+}
+
 #define ARGS_ARRAY_SIZE 8
 static HRESULT execute_preshader(struct d3dx_preshader *pres)
 {
@@ -1688,7 +1703,7 @@ static HRESULT execute_preshader(struct d3dx_preshader *pres)
             {
                 for (k = 0; k < oi->input_count; ++k)
                     args[k] = exec_get_arg(&pres->regs, &ins->inputs[k], ins->scalar_op && !k ? 0 : j);
-                res = oi->func(args, ins->component_count);
+                res = exec_op(oi, ins->op, args, ins->component_count);
                 exec_set_arg(&pres->regs, &ins->output.reg, j, res);
             }
         }
@@ -1875,6 +1875,76 @@ void point_filter_argb_pixels(const BYTE *src, UINT src_row_pitch, UINT src_slic
     }
 }
 
+struct dxtn_compress_context
+{
+    const BYTE *src;
+    BYTE *dst;
+    unsigned int width, height;
+    unsigned int dst_pitch, dst_row_stride;
+    GLenum gl_format;
+    unsigned int band_height;
+    LONG next_band;
+};
+
+static void dxtn_compress_band(struct dxtn_compress_context *ctx, unsigned int band)
+{
+    unsigned int y = band * ctx->band_height;
+    unsigned int height = min(ctx->band_height, ctx->height - y);
+
+    tx_compress_dxtn(4, ctx->width, height, ctx->src + y * ctx->width * sizeof(DWORD),
+            ctx->gl_format, ctx->dst + (y / 4) * ctx->dst_pitch, ctx->dst_row_stride);
+}
+
+static void CALLBACK dxtn_compress_work(TP_CALLBACK_INSTANCE *instance, void *context, TP_WORK *work)
+{
+    struct dxtn_compress_context *ctx = context;
+
+    dxtn_compress_band(ctx, InterlockedIncrement(&ctx->next_band) - 1);
+}
+
+/* Blocks are encoded independently, so large surfaces are split into bands of
+ * block rows which are compressed concurrently on the thread pool. */
+static void compress_dxtn(const BYTE *src, unsigned int width, unsigned int height, GLenum gl_format,
+        BYTE *dst, unsigned int dst_pitch, unsigned int dst_row_stride)
+{
+    struct dxtn_compress_context ctx;
+    unsigned int band_count, i;
+    SYSTEM_INFO info;
+    TP_WORK *work;
+
+    ctx.src = src;
+    ctx.dst = dst;
+    ctx.width = width;
+    ctx.height = height;
+    ctx.dst_pitch = dst_pitch;
+    ctx.dst_row_stride = dst_row_stride;
+    ctx.gl_format = gl_format;
+    ctx.next_band = 0;
+
+    GetSystemInfo(&info);
+    /* Don't bother for small surfaces, the thread pool overhead would dominate. */
+    if (info.dwNumberOfProcessors < 2 || width * height < 256 * 256
+            || !(work = CreateThreadpoolWork(dxtn_compress_work, &ctx, NULL)))
+    {
+        tx_compress_dxtn(4, width, height, src, gl_format, dst, dst_row_stride);
+        return;
+    }
+
+    /* A few bands per processor, to balance uneven per-block encoding costs. */
+    band_count = min(info.dwNumberOfProcessors * 4, (height + 3) / 4);
+    ctx.band_height = ((height + 3) / 4 + band_count - 1) / band_count * 4;
+    band_count = (height + ctx.band_height - 1) / ctx.band_height;
+
+    TRACE("Compressing %u bands of %u rows.\n", band_count, ctx.band_height);
+
+    /* The calling thread takes its share of the bands as well. */
+    for (i = 1; i < band_count; ++i)
+        SubmitThreadpoolWork(work);
+    dxtn_compress_band(&ctx, InterlockedIncrement(&ctx.next_band) - 1);
+    WaitForThreadpoolWorkCallbacks(work, FALSE);
+    CloseThreadpoolWork(work);
+}
+
 /************************************************************
  * D3DXLoadSurfaceFromMemory
  *
@@ -2146,8 +2216,8 @@ HRESULT WINAPI D3DXLoadSurfaceFromMemory(IDirect3DSurface9 *dst_surface,
                 default:
                     ERR("Unexpected destination compressed format %u.\n", surfdesc.Format);
             }
-            tx_compress_dxtn(4, dst_size_aligned.width, dst_size_aligned.height,
-                    dst_uncompressed, gl_format, lockrect.pBits,
+            compress_dxtn(dst_uncompressed, dst_size_aligned.width, dst_size_aligned.height,
+                    gl_format, lockrect.pBits, lockrect.Pitch,
                     lockrect.Pitch * destformatdesc->block_width / destformatdesc->block_byte_count);
             heap_free(dst_uncompressed);
         }
@@ -328,6 +328,37 @@ void mixieee32(float *src, float *dst, unsigned samples)
         *(dst++) += *(src++);
 }
 
+void mixieee32_vol(float *src, float *dst, unsigned frames, unsigned channels, const float *vols)
+{
+    unsigned i, chan;
+
+    TRACE("%p - %p %d %d\n", src, dst, frames, channels);
+
+    /* keep the common layouts free of the inner loop, so that the compiler
+     * can vectorize them */
+    if (channels == 2)
+    {
+        float left = vols[0], right = vols[1];
+        for (i = 0; i < frames; i++)
+        {
+            dst[2 * i] += src[2 * i] * left;
+            dst[2 * i + 1] += src[2 * i + 1] * right;
+        }
+    }
+    else if (channels == 1)
+    {
+        float vol = vols[0];
+        for (i = 0; i < frames; i++)
+            dst[i] += src[i] * vol;
+    }
+    else
+    {
+        for (i = 0; i < frames; i++, src += channels, dst += channels)
+            for (chan = 0; chan < channels; chan++)
+                dst[chan] += src[chan] * vols[chan];
+    }
+}
+
 static void norm8(float *src, unsigned char *dst, unsigned samples)
 {
     TRACE("%p - %p %d\n", src, dst, samples);
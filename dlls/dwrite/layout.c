@@ -209,6 +209,7 @@ enum layout_recompute_mask {
     RECOMPUTE_MINIMAL_WIDTH       = 1 << 1,
     RECOMPUTE_LINES               = 1 << 2,
     RECOMPUTE_OVERHANGS           = 1 << 3,
+    RECOMPUTE_GLYPHS              = 1 << 4,
     RECOMPUTE_LINES_AND_OVERHANGS = RECOMPUTE_LINES | RECOMPUTE_OVERHANGS,
     RECOMPUTE_EVERYTHING          = 0xffff
 };
@@ -330,25 +331,35 @@ static HRESULT alloc_layout_run(enum layout_run_kind kind, unsigned int start_po
     return S_OK;
 }
 
-static void free_layout_runs(struct dwrite_textlayout *layout)
+static void free_layout_run(struct layout_run *run)
+{
+    if (run->kind == LAYOUT_RUN_REGULAR)
+    {
+        if (run->u.regular.run.fontFace)
+            IDWriteFontFace_Release(run->u.regular.run.fontFace);
+        free(run->u.regular.glyphs);
+        free(run->u.regular.clustermap);
+        free(run->u.regular.advances);
+        free(run->u.regular.offsets);
+    }
+    free(run);
+}
+
+static void free_layout_run_list(struct list *runs)
 {
     struct layout_run *cur, *cur2;
-    LIST_FOR_EACH_ENTRY_SAFE(cur, cur2, &layout->runs, struct layout_run, entry)
+    LIST_FOR_EACH_ENTRY_SAFE(cur, cur2, runs, struct layout_run, entry)
     {
         list_remove(&cur->entry);
-        if (cur->kind == LAYOUT_RUN_REGULAR)
-        {
-            if (cur->u.regular.run.fontFace)
-                IDWriteFontFace_Release(cur->u.regular.run.fontFace);
-            free(cur->u.regular.glyphs);
-            free(cur->u.regular.clustermap);
-            free(cur->u.regular.advances);
-            free(cur->u.regular.offsets);
-        }
-        free(cur);
+        free_layout_run(cur);
     }
 }
 
+static void free_layout_runs(struct dwrite_textlayout *layout)
+{
+    free_layout_run_list(&layout->runs);
+}
+
 static void free_layout_eruns(struct dwrite_textlayout *layout)
 {
     struct layout_effective_inline *in, *in2;
@@ -1147,13 +1158,71 @@ static HRESULT layout_shape_run(struct dwrite_textlayout *layout, struct regular
     return hr;
 }
 
+/* Takes over glyph data from a previously shaped run covering the same text with the same font and
+   analysis. 'cache' holds runs from previous computation in text order, entries that can't match
+   any of remaining runs are released as we go. */
+static BOOL layout_reuse_shaped_run(struct dwrite_textlayout *layout, struct list *cache, struct regular_layout_run *run)
+{
+    struct layout_run *r, *r2;
+
+    LIST_FOR_EACH_ENTRY_SAFE(r, r2, cache, struct layout_run, entry)
+    {
+        struct regular_layout_run *cached = &r->u.regular;
+
+        if (r->start_position > run->descr.textPosition)
+            break;
+
+        list_remove(&r->entry);
+
+        if (r->kind == LAYOUT_RUN_REGULAR && cached->advances && cached->offsets
+                && cached->descr.textPosition == run->descr.textPosition
+                && cached->descr.stringLength == run->descr.stringLength
+                && cached->run.fontFace == run->run.fontFace
+                && cached->run.fontEmSize == run->run.fontEmSize
+                && cached->run.isSideways == run->run.isSideways
+                && cached->run.bidiLevel == run->run.bidiLevel
+                && !memcmp(&cached->sa, &run->sa, sizeof(run->sa)))
+        {
+            run->descr.localeName = get_layout_range_by_pos(layout, run->descr.textPosition)->locale;
+            run->glyphs = cached->glyphs;
+            run->clustermap = cached->clustermap;
+            run->advances = cached->advances;
+            run->offsets = cached->offsets;
+            run->glyphcount = cached->glyphcount;
+            run->run.glyphIndices = run->glyphs;
+            run->run.glyphAdvances = run->advances;
+            run->run.glyphOffsets = run->offsets;
+            run->run.glyphCount = cached->run.glyphCount;
+            run->descr.clusterMap = run->clustermap;
+
+            cached->glyphs = NULL;
+            cached->clustermap = NULL;
+            cached->advances = NULL;
+            cached->offsets = NULL;
+            free_layout_run(r);
+            return TRUE;
+        }
+
+        free_layout_run(r);
+    }
+
+    return FALSE;
+}
+
 static HRESULT layout_compute_runs(struct dwrite_textlayout *layout)
 {
+    struct list cached_runs;
     struct layout_run *r;
     UINT32 cluster = 0;
     HRESULT hr;
 
     free_layout_eruns(layout);
+
+    /* Unless shaping input has changed, runs from previous computation are kept around,
+       so that identical runs don't have to be shaped again. */
+    list_init(&cached_runs);
+    if (!(layout->recompute & RECOMPUTE_GLYPHS))
+        list_move_tail(&cached_runs, &layout->runs);
     free_layout_runs(layout);
 
     /* Cluster data arrays are allocated once, assuming one text position per cluster. */
@@ -1165,6 +1234,7 @@ static HRESULT layout_compute_runs(struct dwrite_textlayout *layout)
         {
             free(layout->clustermetrics);
             free(layout->clusters);
+            free_layout_run_list(&cached_runs);
             return E_OUTOFMEMORY;
         }
     }
@@ -1172,11 +1242,13 @@ static HRESULT layout_compute_runs(struct dwrite_textlayout *layout)
 
     if (FAILED(hr = layout_itemize(layout))) {
         WARN("Itemization failed, hr %#lx.\n", hr);
+        free_layout_run_list(&cached_runs);
         return hr;
     }
 
     if (FAILED(hr = layout_resolve_fonts(layout))) {
         WARN("Failed to resolve layout fonts, hr %#lx.\n", hr);
+        free_layout_run_list(&cached_runs);
         return hr;
     }
 
@@ -1218,7 +1290,9 @@ static HRESULT layout_compute_runs(struct dwrite_textlayout *layout)
             continue;
         }
 
-        if (FAILED(hr = layout_shape_run(layout, run)))
+        if (layout_reuse_shaped_run(layout, &cached_runs, run))
+            hr = S_OK;
+        else if (FAILED(hr = layout_shape_run(layout, run)))
             WARN("%s: shaping failed, hr %#lx.\n", debugstr_rundescr(&run->descr), hr);
 
         /* baseline derived from font metrics */
@@ -1228,6 +1302,8 @@ static HRESULT layout_compute_runs(struct dwrite_textlayout *layout)
         layout_set_cluster_metrics(layout, r, &cluster);
     }
 
+    free_layout_run_list(&cached_runs);
+
     if (hr == S_OK) {
         layout->cluster_count = cluster;
         if (cluster)
@@ -1278,7 +1354,7 @@ static HRESULT layout_compute(struct dwrite_textlayout *layout)
         }
     }
 
-    layout->recompute &= ~RECOMPUTE_CLUSTERS;
+    layout->recompute &= ~(RECOMPUTE_CLUSTERS | RECOMPUTE_GLYPHS);
     return hr;
 }
 
@@ -2665,6 +2741,26 @@ static inline HRESULT return_range(const struct layout_range_header *h, DWRITE_T
     return S_OK;
 }
 
+/* Returns what has to be recomputed when given attribute changes. Decorations and drawing effects only split
+   effective runs, while typographic features, spacing and locale make previously shaped glyphs unusable. */
+static USHORT get_layout_range_attr_recompute_mask(enum layout_range_attr_kind attr)
+{
+    switch (attr)
+    {
+    case LAYOUT_RANGE_ATTR_EFFECT:
+    case LAYOUT_RANGE_ATTR_UNDERLINE:
+    case LAYOUT_RANGE_ATTR_STRIKETHROUGH:
+        return RECOMPUTE_LINES_AND_OVERHANGS;
+    case LAYOUT_RANGE_ATTR_PAIR_KERNING:
+    case LAYOUT_RANGE_ATTR_LOCALE:
+    case LAYOUT_RANGE_ATTR_SPACING:
+    case LAYOUT_RANGE_ATTR_TYPOGRAPHY:
+        return RECOMPUTE_EVERYTHING;
+    default:
+        return RECOMPUTE_EVERYTHING & ~RECOMPUTE_GLYPHS;
+    }
+}
+
 /* Sets attribute value for given range, does all needed splitting/merging of existing ranges. */
 static HRESULT set_layout_range_attr(struct dwrite_textlayout *layout, enum layout_range_attr_kind attr, struct layout_range_attr_value *value)
 {
@@ -2772,7 +2868,7 @@ static HRESULT set_layout_range_attr(struct dwrite_textlayout *layout, enum layo
         list_add_after(&outer->entry, &cur->entry);
         list_add_after(&cur->entry, &right->entry);
 
-        layout->recompute = RECOMPUTE_EVERYTHING;
+        layout->recompute |= get_layout_range_attr_recompute_mask(attr);
         return S_OK;
     }
 
@@ -2812,7 +2908,7 @@ done:
     if (changed) {
         struct list *next, *i;
 
-        layout->recompute = RECOMPUTE_EVERYTHING;
+        layout->recompute |= get_layout_range_attr_recompute_mask(attr);
         i = list_head(ranges);
         while ((next = list_next(ranges, i))) {
             struct layout_range_header *next_range = LIST_ENTRY(next, struct layout_range_header, entry);
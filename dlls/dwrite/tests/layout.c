@@ -886,6 +886,9 @@ struct renderer_context {
     FLOAT originY;
     IDWriteTextFormat *format;
     const WCHAR *familyW;
+    UINT16 glyphs[16];
+    FLOAT advances[16];
+    UINT32 glyph_count;
 };
 
 static HRESULT WINAPI testrenderer_IsPixelSnappingDisabled(IDWriteTextRenderer *iface,
@@ -941,11 +944,17 @@ static HRESULT WINAPI testrenderer_DrawGlyphRun(IDWriteTextRenderer *iface,
     struct renderer_context *ctxt = (struct renderer_context*)context;
     struct drawcall_entry entry;
     DWRITE_SCRIPT_ANALYSIS sa;
+    UINT32 i;
 
     if (ctxt) {
         TEST_MEASURING_MODE(ctxt, mode);
         ctxt->originX = baselineOriginX;
         ctxt->originY = baselineOriginY;
+        for (i = 0; i < run->glyphCount && ctxt->glyph_count < ARRAY_SIZE(ctxt->glyphs); i++)
+        {
+            ctxt->glyphs[ctxt->glyph_count] = run->glyphIndices[i];
+            ctxt->advances[ctxt->glyph_count++] = run->glyphAdvances[i];
+        }
     }
 
     ok(descr->stringLength < ARRAY_SIZE(entry.string), "string is too long\n");
@@ -959,8 +968,6 @@ static HRESULT WINAPI testrenderer_DrawGlyphRun(IDWriteTextRenderer *iface,
     /* see what's reported for control codes runs */
     get_script_analysis(descr->string, descr->stringLength, &sa);
     if (sa.shapes == DWRITE_SCRIPT_SHAPES_NO_VISUAL) {
-        UINT32 i;
-
         /* glyphs are not reported at all for control code runs */
         ok(run->glyphCount == 0, "got %u\n", run->glyphCount);
         ok(run->glyphAdvances != NULL, "advances array %p\n", run->glyphAdvances);
@@ -5691,6 +5698,130 @@ static void test_SetTypography(void)
     IDWriteFactory_Release(factory);
 }
 
+static void draw_layout_glyphs(IDWriteTextLayout *layout, struct renderer_context *ctxt)
+{
+    HRESULT hr;
+
+    memset(ctxt, 0, sizeof(*ctxt));
+    ctxt->snapping_disabled = TRUE;
+    hr = IDWriteTextLayout_Draw(layout, ctxt, &testrenderer, 0.0f, 0.0f);
+    ok(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+}
+
+static void test_relayout(void)
+{
+    struct renderer_context ctxt, ctxt2;
+    DWRITE_CLUSTER_METRICS clusters[7];
+    DWRITE_FONT_FEATURE feature;
+    IDWriteTypography *typography;
+    IDWriteTextFormat *format;
+    IDWriteTextLayout *layout;
+    IDWriteFactory *factory;
+    DWRITE_TEXT_RANGE r;
+    IUnknown *effect;
+    UINT32 count, i;
+    HRESULT hr;
+
+    factory = create_factory();
+
+    effect = create_test_effect();
+
+    hr = IDWriteFactory_CreateTextFormat(factory, L"Tahoma", NULL, DWRITE_FONT_WEIGHT_NORMAL, DWRITE_FONT_STYLE_NORMAL,
+            DWRITE_FONT_STRETCH_NORMAL, 10.0f, L"en-us", &format);
+    ok(hr == S_OK, "Failed to create text format, hr %#lx.\n", hr);
+
+    hr = IDWriteFactory_CreateTextLayout(factory, L"abc def", 7, format, 500.0f, 1000.0f, &layout);
+    ok(hr == S_OK, "Failed to create text layout, hr %#lx.\n", hr);
+
+    r.startPosition = 4;
+    r.length = 3;
+    hr = IDWriteTextLayout_SetFontSize(layout, 12.0f, r);
+    ok(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+
+    draw_layout_glyphs(layout, &ctxt);
+    ok(ctxt.glyph_count == 7, "Unexpected glyph count %u.\n", ctxt.glyph_count);
+
+    /* Drawing effects don't affect shaping. */
+    r.startPosition = 0;
+    r.length = 7;
+    hr = IDWriteTextLayout_SetDrawingEffect(layout, effect, r);
+    ok(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+
+    draw_layout_glyphs(layout, &ctxt2);
+    ok(ctxt2.glyph_count == ctxt.glyph_count, "Unexpected glyph count %u.\n", ctxt2.glyph_count);
+    for (i = 0; i < ctxt.glyph_count; i++)
+    {
+        winetest_push_context("glyph %u", i);
+        ok(ctxt2.glyphs[i] == ctxt.glyphs[i], "Unexpected glyph %u.\n", ctxt2.glyphs[i]);
+        ok(ctxt2.advances[i] == ctxt.advances[i], "Unexpected advance %.8e.\n", ctxt2.advances[i]);
+        winetest_pop_context();
+    }
+
+    /* Font size change on a part of the text, the rest of the runs are unchanged. */
+    r.startPosition = 4;
+    r.length = 3;
+    hr = IDWriteTextLayout_SetFontSize(layout, 20.0f, r);
+    ok(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+
+    draw_layout_glyphs(layout, &ctxt2);
+    ok(ctxt2.glyph_count == ctxt.glyph_count, "Unexpected glyph count %u.\n", ctxt2.glyph_count);
+    for (i = 0; i < ctxt.glyph_count; i++)
+    {
+        winetest_push_context("glyph %u", i);
+        ok(ctxt2.glyphs[i] == ctxt.glyphs[i], "Unexpected glyph %u.\n", ctxt2.glyphs[i]);
+        if (i < 4)
+            ok(ctxt2.advances[i] == ctxt.advances[i], "Unexpected advance %.8e.\n", ctxt2.advances[i]);
+        else
+            ok(ctxt2.advances[i] > ctxt.advances[i], "Unexpected advance %.8e.\n", ctxt2.advances[i]);
+        winetest_pop_context();
+    }
+
+    count = 0;
+    hr = IDWriteTextLayout_GetClusterMetrics(layout, clusters, ARRAY_SIZE(clusters), &count);
+    ok(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+    ok(count == 7, "Unexpected cluster count %u.\n", count);
+    for (i = 0; i < count; i++)
+        ok(clusters[i].width == ctxt2.advances[i], "%u: unexpected width %.8e.\n", i, clusters[i].width);
+
+    IDWriteTextLayout_Release(layout);
+
+    /* Typographic features are shaping input, text is shaped again. Bundled
+       Tahoma has a "fi" ligature. */
+    hr = IDWriteFactory_CreateTextLayout(factory, L"fi", 2, format, 500.0f, 1000.0f, &layout);
+    ok(hr == S_OK, "Failed to create text layout, hr %#lx.\n", hr);
+
+    count = 0;
+    hr = IDWriteTextLayout_GetClusterMetrics(layout, clusters, ARRAY_SIZE(clusters), &count);
+    ok(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+    ok(count == 1 || broken(count == 2) /* Windows Tahoma has no ligatures */, "Unexpected cluster count %u.\n", count);
+
+    hr = IDWriteFactory_CreateTypography(factory, &typography);
+    ok(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+
+    feature.nameTag = DWRITE_FONT_FEATURE_TAG_STANDARD_LIGATURES;
+    feature.parameter = 0;
+    hr = IDWriteTypography_AddFontFeature(typography, feature);
+    ok(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+
+    r.startPosition = 0;
+    r.length = 2;
+    hr = IDWriteTextLayout_SetTypography(layout, typography, r);
+    ok(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+    IDWriteTypography_Release(typography);
+
+    count = 0;
+    hr = IDWriteTextLayout_GetClusterMetrics(layout, clusters, ARRAY_SIZE(clusters), &count);
+    ok(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+    ok(count == 2, "Unexpected cluster count %u.\n", count);
+
+    flush_sequence(sequences, RENDERER_ID);
+
+    IDWriteTextLayout_Release(layout);
+    IDWriteTextFormat_Release(format);
+    IUnknown_Release(effect);
+    IDWriteFactory_Release(factory);
+}
+
 static void test_SetLastLineWrapping(void)
 {
     IDWriteTextLayout2 *layout2;
@@ -7097,6 +7228,7 @@ START_TEST(layout)
     test_system_fallback();
     test_FontFallbackBuilder();
     test_SetTypography();
+    test_relayout();
     test_SetLastLineWrapping();
     test_SetOpticalAlignment();
     test_SetUnderline();
@@ -963,42 +963,39 @@ static void get_bitmap_sample_size(InterpolationMode interpolation, WrapMode wra
     rect->Height = bottom - top + 1;
 }
 
-static ARGB sample_bitmap_pixel(GDIPCONST GpRect *src_rect, LPBYTE bits, UINT width,
-    UINT height, INT x, INT y, GDIPCONST GpImageAttributes *attributes)
+/* Maps a sample co-ordinate into the image according to the wrap mode, returns
+ * FALSE if it falls outside of a clamped image. */
+static BOOL wrap_sample_coord(INT *coord, UINT size, WrapMode wrap, BOOL flip)
 {
-    if (attributes->wrap == WrapModeClamp)
+    INT c = *coord;
+
+    if (wrap == WrapModeClamp)
+        return c >= 0 && c < size;
+
+    /* Tiling. Make sure co-ordinates are positive as it simplifies the math. */
+    if (c < 0)
+        c = size*2 + c % (INT)(size * 2);
+
+    if (flip)
     {
-        if (x < 0 || y < 0 || x >= width || y >= height)
-            return attributes->outside_color;
+        if ((c / size) % 2 == 0)
+            c = c % size;
+        else
+            c = size - 1 - c % size;
     }
     else
-    {
-        /* Tiling. Make sure co-ordinates are positive as it simplifies the math. */
-        if (x < 0)
-            x = width*2 + x % (INT)(width * 2);
-        if (y < 0)
-            y = height*2 + y % (INT)(height * 2);
+        c = c % size;
 
-        if (attributes->wrap & WrapModeTileFlipX)
-        {
-            if ((x / width) % 2 == 0)
-                x = x % width;
-            else
-                x = width - 1 - x % width;
-        }
-        else
-            x = x % width;
+    *coord = c;
+    return TRUE;
+}
 
-        if (attributes->wrap & WrapModeTileFlipY)
-        {
-            if ((y / height) % 2 == 0)
-                y = y % height;
-            else
-                y = height - 1 - y % height;
-        }
-        else
-            y = y % height;
-    }
+static ARGB sample_bitmap_pixel(GDIPCONST GpRect *src_rect, LPBYTE bits, UINT width,
+    UINT height, INT x, INT y, GDIPCONST GpImageAttributes *attributes)
+{
+    if (!wrap_sample_coord(&x, width, attributes->wrap, attributes->wrap & WrapModeTileFlipX) ||
+        !wrap_sample_coord(&y, height, attributes->wrap, attributes->wrap & WrapModeTileFlipY))
+        return attributes->outside_color;
 
     if (x < src_rect->X || y < src_rect->Y || x >= src_rect->X + src_rect->Width || y >= src_rect->Y + src_rect->Height)
     {
@@ -1009,6 +1006,21 @@ static ARGB sample_bitmap_pixel(GDIPCONST GpRect *src_rect, LPBYTE bits, UINT wi
     return ((DWORD*)(bits))[(x - src_rect->X) + (y - src_rect->Y) * src_rect->Width];
 }
 
+static FLOAT get_nearest_pixel_offset(PixelOffsetMode offset_mode)
+{
+    switch (offset_mode)
+    {
+    default:
+    case PixelOffsetModeNone:
+    case PixelOffsetModeHighSpeed:
+        return 0.5;
+
+    case PixelOffsetModeHalf:
+    case PixelOffsetModeHighQuality:
+        return 0.0;
+    }
+}
+
 static ARGB resample_bitmap_pixel(GDIPCONST GpRect *src_rect, LPBYTE bits, UINT width,
     UINT height, GpPointF *point, GDIPCONST GpImageAttributes *attributes,
     InterpolationMode interpolation, PixelOffsetMode offset_mode)
@@ -1057,25 +1069,134 @@ static ARGB resample_bitmap_pixel(GDIPCONST GpRect *src_rect, LPBYTE bits, UINT
     }
     case InterpolationModeNearestNeighbor:
     {
-        FLOAT pixel_offset;
-        switch (offset_mode)
+        FLOAT pixel_offset = get_nearest_pixel_offset(offset_mode);
+        return sample_bitmap_pixel(src_rect, bits, width, height,
+            floorf(point->X + pixel_offset), floorf(point->Y + pixel_offset), attributes);
+    }
+
+    }
+}
+
+/* Source sampling parameters for a single destination row or column. */
+struct sample_axis
+{
+    INT pos[2];     /* source positions relative to the sampled area, -1 for outside colour,
+                       -2 for positions outside the sampled area */
+    REAL weight;    /* weight of pos[1] */
+    BOOL exact;     /* both positions are the same unwrapped source pixel */
+    BOOL inside;    /* sample point lies within the requested source rectangle */
+};
+
+static void init_sample_axis(struct sample_axis *axis, INT count, INT first, REAL origin, REAL delta,
+    REAL src_start, REAL src_size, INT area_start, INT area_size, UINT size, WrapMode wrap, BOOL flip,
+    BOOL nearest, FLOAT pixel_offset)
+{
+    INT i, j, pos[2];
+    REAL v, vf;
+
+    for (i = 0; i < count; i++)
+    {
+        v = origin + (first + i) * delta;
+
+        axis[i].inside = v >= src_start && v < src_start + src_size;
+        if (nearest)
         {
-        default:
-        case PixelOffsetModeNone:
-        case PixelOffsetModeHighSpeed:
-            pixel_offset = 0.5;
-            break;
+            pos[0] = pos[1] = floorf(v + pixel_offset);
+            axis[i].weight = 0.0;
+        }
+        else
+        {
+            vf = floorf(v);
+            pos[0] = (INT)vf;
+            pos[1] = (INT)ceilf(v);
+            axis[i].weight = v - vf;
+        }
+        axis[i].exact = pos[0] == pos[1];
 
-        case PixelOffsetModeHalf:
-        case PixelOffsetModeHighQuality:
-            pixel_offset = 0.0;
-            break;
+        for (j = 0; j < 2; j++)
+        {
+            if (!wrap_sample_coord(&pos[j], size, wrap, flip))
+                axis[i].pos[j] = -1;
+            else if (pos[j] < area_start || pos[j] >= area_start + area_size)
+            {
+                ERR("out of range pixel requested\n");
+                axis[i].pos[j] = -2;
+            }
+            else
+                axis[i].pos[j] = pos[j] - area_start;
         }
-        return sample_bitmap_pixel(src_rect, bits, width, height,
-            floorf(point->X + pixel_offset), floorf(point->Y + pixel_offset), attributes);
     }
+}
+
+static inline ARGB get_axis_sample(const ARGB *bits, INT stride, const struct sample_axis *x_axis, INT x_idx,
+    const struct sample_axis *y_axis, INT y_idx, ARGB outside_color)
+{
+    if (x_axis->pos[x_idx] == -1 || y_axis->pos[y_idx] == -1)
+        return outside_color;
+    if (x_axis->pos[x_idx] < 0 || y_axis->pos[y_idx] < 0)
+        return 0xffcd0084;
+    return bits[x_axis->pos[x_idx] + y_axis->pos[y_idx] * stride];
+}
+
+/* Same as calling resample_bitmap_pixel() for every destination pixel, for the
+ * case when the source is only scaled and translated. Each source co-ordinate
+ * then depends on a single destination axis, so sample positions, wrapping and
+ * weights are computed once per row and column, and rows are written in order. */
+static GpStatus resample_bitmap_scaled(GDIPCONST GpRect *src_rect, const ARGB *src_bits, UINT width,
+    UINT height, GDIPCONST RECT *dst_area, ARGB *dst_bits, const GpPointF *origin, REAL x_dx, REAL y_dy,
+    REAL srcx, REAL srcy, REAL srcwidth, REAL srcheight, GDIPCONST GpImageAttributes *attributes,
+    InterpolationMode interpolation, PixelOffsetMode offset_mode)
+{
+    INT dst_width = dst_area->right - dst_area->left, dst_height = dst_area->bottom - dst_area->top;
+    BOOL nearest = interpolation == InterpolationModeNearestNeighbor;
+    const struct sample_axis *sx, *sy;
+    struct sample_axis *columns, *rows;
+    FLOAT pixel_offset = 0.0;
+    ARGB top, bottom;
+    static int fixme;
+    INT x, y;
 
+    if (nearest)
+        pixel_offset = get_nearest_pixel_offset(offset_mode);
+    else if (interpolation != InterpolationModeBilinear && !fixme++)
+        FIXME("Unimplemented interpolation %i\n", interpolation);
+
+    columns = heap_alloc(sizeof(*columns) * (dst_width + dst_height));
+    if (!columns)
+        return OutOfMemory;
+    rows = columns + dst_width;
+
+    init_sample_axis(columns, dst_width, dst_area->left, origin->X, x_dx, srcx, srcwidth,
+        src_rect->X, src_rect->Width, width, attributes->wrap, attributes->wrap & WrapModeTileFlipX,
+        nearest, pixel_offset);
+    init_sample_axis(rows, dst_height, dst_area->top, origin->Y, y_dy, srcy, srcheight,
+        src_rect->Y, src_rect->Height, height, attributes->wrap, attributes->wrap & WrapModeTileFlipY,
+        nearest, pixel_offset);
+
+    for (y = 0; y < dst_height; y++)
+    {
+        sy = &rows[y];
+        for (x = 0; x < dst_width; x++, dst_bits++)
+        {
+            sx = &columns[x];
+
+            if (!sx->inside || !sy->inside)
+                *dst_bits = 0;
+            else if (nearest || (sx->exact && sy->exact))
+                *dst_bits = get_axis_sample(src_bits, src_rect->Width, sx, 0, sy, 0, attributes->outside_color);
+            else
+            {
+                top = blend_colors(get_axis_sample(src_bits, src_rect->Width, sx, 0, sy, 0, attributes->outside_color),
+                    get_axis_sample(src_bits, src_rect->Width, sx, 1, sy, 0, attributes->outside_color), sx->weight);
+                bottom = blend_colors(get_axis_sample(src_bits, src_rect->Width, sx, 0, sy, 1, attributes->outside_color),
+                    get_axis_sample(src_bits, src_rect->Width, sx, 1, sy, 1, attributes->outside_color), sx->weight);
+                *dst_bits = blend_colors(top, bottom, sy->weight);
+            }
+        }
     }
+
+    heap_free(columns);
+    return Ok;
 }
 
 static REAL intersect_line_scanline(const GpPointF *p1, const GpPointF *p2, REAL y)
@@ -3265,23 +3386,38 @@ GpStatus WINGDIPAPI GdipDrawImagePointsRect(GpGraphics *graphics, GpImage *image
                 y_dx = dst_to_src_points[2].X - dst_to_src_points[0].X;
                 y_dy = dst_to_src_points[2].Y - dst_to_src_points[0].Y;
 
-                for (x=dst_area.left; x<dst_area.right; x++)
+                if (x_dy == 0.0 && y_dx == 0.0)
+                {
+                    stat = resample_bitmap_scaled(&src_area, (const ARGB *)src_data, bitmap->width, bitmap->height,
+                        &dst_area, (ARGB *)dst_data, &dst_to_src_points[0], x_dx, y_dy,
+                        srcx, srcy, srcwidth, srcheight, imageAttributes, interpolation, offset_mode);
+                    if (stat != Ok)
+                    {
+                        heap_free(src_data);
+                        heap_free(dst_dyn_data);
+                        return stat;
+                    }
+                }
+                else
                 {
                     for (y=dst_area.top; y<dst_area.bottom; y++)
                     {
-                        GpPointF src_pointf;
-                        ARGB *dst_color;
+                        for (x=dst_area.left; x<dst_area.right; x++)
+                        {
+                            GpPointF src_pointf;
+                            ARGB *dst_color;
 
-                        src_pointf.X = dst_to_src_points[0].X + x * x_dx + y * y_dx;
-                        src_pointf.Y = dst_to_src_points[0].Y + x * x_dy + y * y_dy;
+                            src_pointf.X = dst_to_src_points[0].X + x * x_dx + y * y_dx;
+                            src_pointf.Y = dst_to_src_points[0].Y + x * x_dy + y * y_dy;
 
-                        dst_color = (ARGB*)(dst_data + dst_stride * (y - dst_area.top) + sizeof(ARGB) * (x - dst_area.left));
+                            dst_color = (ARGB*)(dst_data + dst_stride * (y - dst_area.top) + sizeof(ARGB) * (x - dst_area.left));
 
-                        if (src_pointf.X >= srcx && src_pointf.X < srcx + srcwidth && src_pointf.Y >= srcy && src_pointf.Y < srcy+srcheight)
-                            *dst_color = resample_bitmap_pixel(&src_area, src_data, bitmap->width, bitmap->height, &src_pointf,
-                                                               imageAttributes, interpolation, offset_mode);
-                        else
-                            *dst_color = 0;
+                            if (src_pointf.X >= srcx && src_pointf.X < srcx + srcwidth && src_pointf.Y >= srcy && src_pointf.Y < srcy+srcheight)
+                                *dst_color = resample_bitmap_pixel(&src_area, src_data, bitmap->width, bitmap->height, &src_pointf,
+                                                                   imageAttributes, interpolation, offset_mode);
+                            else
+                                *dst_color = 0;
+                        }
                     }
                 }
             }
@@ -414,6 +414,19 @@ static HRESULT push_instr_uint(compiler_ctx_t *ctx, jsop_t op, unsigned arg)
     return S_OK;
 }
 
+static HRESULT push_instr_uint_uint(compiler_ctx_t *ctx, jsop_t op, unsigned arg1, unsigned arg2)
+{
+    unsigned instr;
+
+    instr = push_instr(ctx, op);
+    if(!instr)
+        return E_OUTOFMEMORY;
+
+    instr_ptr(ctx, instr)->u.arg[0].uint = arg1;
+    instr_ptr(ctx, instr)->u.arg[1].uint = arg2;
+    return S_OK;
+}
+
 static HRESULT compile_binary_expression(compiler_ctx_t *ctx, binary_expression_t *expr, jsop_t op)
 {
     HRESULT hres;
@@ -449,7 +462,7 @@ static HRESULT compile_member_expression(compiler_ctx_t *ctx, member_expression_
     if(FAILED(hres))
         return hres;
 
-    return push_instr_bstr(ctx, OP_member, expr->identifier);
+    return push_instr_bstr_uint(ctx, OP_member, expr->identifier, ctx->code->prop_cache_cnt++);
 }
 
 #define LABEL_FLAG 0x80000000
@@ -599,7 +612,7 @@ static HRESULT compile_memberid_expression(compiler_ctx_t *ctx, expression_t *ex
     if(FAILED(hres))
         return hres;
 
-    return push_instr_uint(ctx, OP_memberid, flags);
+    return push_instr_uint_uint(ctx, OP_memberid, flags, ctx->code->prop_cache_cnt++);
 }
 
 static HRESULT compile_increment_expression(compiler_ctx_t *ctx, unary_expression_t *expr, jsop_t op, int n)
@@ -2470,6 +2483,7 @@ void release_bytecode(bytecode_t *code)
     heap_pool_free(&code->heap);
     free(code->bstr_pool);
     free(code->str_pool);
+    free(code->prop_caches);
     free(code->instrs);
     free(code);
 }
@@ -2762,6 +2776,14 @@ HRESULT compile_script(script_ctx_t *ctx, const WCHAR *code, UINT64 source_conte
         return DISP_E_EXCEPTION;
     }
 
+    if(compiler.code->prop_cache_cnt) {
+        compiler.code->prop_caches = calloc(compiler.code->prop_cache_cnt, sizeof(*compiler.code->prop_caches));
+        if(!compiler.code->prop_caches) {
+            release_bytecode(compiler.code);
+            return E_OUTOFMEMORY;
+        }
+    }
+
     if(named_item) {
         compiler.code->named_item = named_item;
         named_item->ref++;
@@ -202,8 +202,16 @@ found:
 static inline unsigned string_hash(const WCHAR *name)
 {
     unsigned h = 0;
-    for(; *name; name++)
-        h = (h>>(sizeof(unsigned)*8-4)) ^ (h<<4) ^ towlower(*name);
+    WCHAR c;
+
+    /* Property names are nearly always ASCII, avoid calling towlower() for those */
+    for(; (c = *name); name++) {
+        if(c < 0x80)
+            c = (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+        else
+            c = towlower(c);
+        h = (h>>(sizeof(unsigned)*8-4)) ^ (h<<4) ^ c;
+    }
     return h;
 }
 
@@ -1054,6 +1062,9 @@ static jsdisp_t *gc_stack_pop(struct gc_ctx *gc_ctx)
     return obj;
 }
 
+/* Minimum number of objects created between automatic GC runs */
+#define GC_MIN_ALLOC_COUNT 10000
+
 HRESULT gc_run(script_ctx_t *ctx)
 {
     /* Save original refcounts in a linked list of chunks */
@@ -1231,6 +1242,8 @@ HRESULT gc_run(script_ctx_t *ctx)
 
     ctx->gc_is_unlinking = FALSE;
     ctx->gc_last_tick = GetTickCount();
+    ctx->gc_alloc_count = 0;
+    ctx->gc_live_count = list_count(&ctx->objects);
     return S_OK;
 }
 
@@ -2775,12 +2788,18 @@ jsdisp_t *to_jsdisp(IDispatch *disp)
     return disp->lpVtbl == (IDispatchVtbl*)&WineDispatchProxyCbPrivateVtbl ? impl_from_IDispatchEx((IDispatchEx*)disp) : NULL;
 }
 
+static LONG64 last_serial;
+
 HRESULT init_dispex(jsdisp_t *dispex, script_ctx_t *ctx, const builtin_info_t *builtin_info, jsdisp_t *prototype)
 {
     unsigned i;
 
-    /* FIXME: Use better heuristics to decide when to run the GC */
-    if(GetTickCount() - ctx->gc_last_tick > 30000)
+    /* Run the GC once as many objects have been created since the last run as
+       survived it, so its cost is proportional to the allocation rate and garbage
+       cycles can't grow unbounded between runs. Also run it periodically, for
+       scripts that hold on to a large heap but allocate slowly. */
+    if(++ctx->gc_alloc_count > max(GC_MIN_ALLOC_COUNT, ctx->gc_live_count)
+            || GetTickCount() - ctx->gc_last_tick > 30000)
         gc_run(ctx);
 
     TRACE("%p (%p)\n", dispex, prototype);
@@ -2790,6 +2809,7 @@ HRESULT init_dispex(jsdisp_t *dispex, script_ctx_t *ctx, const builtin_info_t *b
     dispex->builtin_info = builtin_info;
     dispex->extensible = TRUE;
     dispex->prop_cnt = 0;
+    dispex->serial = InterlockedIncrement64(&last_serial);
 
     dispex->props = calloc(1, sizeof(dispex_prop_t)*(dispex->buf_size=4));
     if(!dispex->props)
@@ -3037,6 +3057,41 @@ jsdisp_t *iface_to_jsdisp(IDispatch *iface)
         : NULL;
 }
 
+static inline BOOL is_cacheable_prop(const dispex_prop_t *prop)
+{
+    return prop->type == PROP_JSVAL || prop->type == PROP_BUILTIN || prop->type == PROP_ACCESSOR
+        || prop->type == PROP_PROTREF;
+}
+
+/* Looks up the property like jsdisp_get_id with no flags, but first tries the property
+ * found by the previous lookup through the same cache. Property ids stay valid for the
+ * object's lifetime, so the cached one only needs to be checked for deletion. */
+HRESULT jsdisp_get_id_cached(jsdisp_t *jsdisp, const WCHAR *name, prop_cache_t *cache, DISPID *id)
+{
+    dispex_prop_t *prop;
+    HRESULT hres;
+
+    if(cache->obj == jsdisp && cache->serial == jsdisp->serial) {
+        prop = &jsdisp->props[cache->id - 1];
+        fix_protref_prop(jsdisp, prop);
+        if(is_cacheable_prop(prop) && (prop->name == name || !wcscmp(prop->name, name))) {
+            *id = cache->id;
+            return S_OK;
+        }
+    }
+
+    hres = jsdisp_get_id(jsdisp, name, 0, id);
+    if(FAILED(hres))
+        return hres;
+
+    if(!jsdisp->proxy && is_cacheable_prop(&jsdisp->props[*id - 1])) {
+        cache->obj = jsdisp;
+        cache->serial = jsdisp->serial;
+        cache->id = *id;
+    }
+    return S_OK;
+}
+
 HRESULT jsdisp_get_id(jsdisp_t *jsdisp, const WCHAR *name, DWORD flags, DISPID *id)
 {
     dispex_prop_t *prop;
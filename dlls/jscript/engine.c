@@ -856,6 +856,12 @@ static inline unsigned get_op_uint(script_ctx_t *ctx, int i)
     return frame->bytecode->instrs[frame->ip].u.arg[i].uint;
 }
 
+static inline prop_cache_t *get_op_prop_cache(script_ctx_t *ctx, int i)
+{
+    call_frame_t *frame = ctx->call_ctx;
+    return &frame->bytecode->prop_caches[frame->bytecode->instrs[frame->ip].u.arg[i].uint];
+}
+
 static inline unsigned get_op_int(script_ctx_t *ctx, int i)
 {
     call_frame_t *frame = ctx->call_ctx;
@@ -1315,6 +1321,18 @@ static HRESULT interp_array(script_ctx_t *ctx)
     return stack_push(ctx, v);
 }
 
+/* looks up a property from a bytecode site, hitting the site's cache for
+ * script objects that were looked up there before */
+static HRESULT disp_get_id_cached(script_ctx_t *ctx, IDispatch *disp, const WCHAR *name, BSTR name_bstr,
+                                  prop_cache_t *cache, DISPID *id)
+{
+    jsdisp_t *jsdisp = to_jsdisp(disp);
+
+    if(jsdisp && !jsdisp->proxy)
+        return jsdisp_get_id_cached(jsdisp, name, cache, id);
+    return disp_get_id(ctx, disp, name, name_bstr, 0, id);
+}
+
 /* ECMA-262 3rd Edition    11.2.1 */
 static HRESULT interp_member(script_ctx_t *ctx)
 {
@@ -1330,7 +1348,7 @@ static HRESULT interp_member(script_ctx_t *ctx)
     if(FAILED(hres))
         return hres;
 
-    hres = disp_get_id(ctx, obj, arg, arg, 0, &id);
+    hres = disp_get_id_cached(ctx, obj, arg, arg, get_op_prop_cache(ctx, 1), &id);
     if(SUCCEEDED(hres)) {
         hres = disp_propget(ctx, obj, id, &v);
     }else if(hres == DISP_E_UNKNOWNNAME) {
@@ -1372,7 +1390,10 @@ static HRESULT interp_memberid(script_ctx_t *ctx)
     if(FAILED(hres))
         return hres;
 
-    hres = disp_get_id(ctx, obj, name, NULL, arg, &id);
+    if(arg)
+        hres = disp_get_id(ctx, obj, name, NULL, arg, &id);
+    else
+        hres = disp_get_id_cached(ctx, obj, name, NULL, get_op_prop_cache(ctx, 1), &id);
     jsstr_release(name_str);
     if(SUCCEEDED(hres)) {
         ref.type = EXPRVAL_IDREF;
@@ -542,7 +542,7 @@ static void RegExp_destructor(jsdisp_t *dispex)
     RegExpInstance *This = regexp_from_jsdisp(dispex);
 
     if(This->jsregexp)
-        regexp_destroy(This->jsregexp);
+        regexp_release(This->jsregexp);
     jsval_release(This->last_index_val);
     jsstr_release(This->str);
     free(This);
@@ -624,9 +624,77 @@ static HRESULT alloc_regexp(script_ctx_t *ctx, jsstr_t *str, jsdisp_t *object_pr
     return S_OK;
 }
 
+/* Recently compiled regular expressions, keyed by source and flags, so that
+ * literals in loops and string patterns don't get compiled over and over. */
+#define REGEXP_CACHE_SIZE 16
+
+struct regexp_cache {
+    struct {
+        jsstr_t *src;
+        regexp_t *regexp;
+    } entries[REGEXP_CACHE_SIZE];
+    unsigned next;
+};
+
+static regexp_t *compile_regexp(script_ctx_t *ctx, jsstr_t **src, const WCHAR *str, DWORD flags)
+{
+    struct regexp_cache *cache;
+    regexp_t *regexp;
+    unsigned i;
+
+    if(!ctx->regexp_cache)
+        ctx->regexp_cache = calloc(1, sizeof(*ctx->regexp_cache));
+    cache = ctx->regexp_cache;
+
+    if(cache) {
+        for(i = 0; i < ARRAY_SIZE(cache->entries); i++) {
+            if(cache->entries[i].regexp && cache->entries[i].regexp->flags == flags
+               && jsstr_eq(cache->entries[i].src, *src)) {
+                /* The compiled regexp points into the source string, so use the cached one. */
+                *src = cache->entries[i].src;
+                return regexp_addref(cache->entries[i].regexp);
+            }
+        }
+    }
+
+    regexp = regexp_new(ctx, &ctx->tmp_heap, str, jsstr_length(*src), flags, FALSE);
+    if(!regexp || !cache)
+        return regexp;
+
+    i = cache->next;
+    cache->next = (i + 1) % ARRAY_SIZE(cache->entries);
+    if(cache->entries[i].regexp) {
+        regexp_release(cache->entries[i].regexp);
+        jsstr_release(cache->entries[i].src);
+    }
+    cache->entries[i].src = jsstr_addref(*src);
+    cache->entries[i].regexp = regexp_addref(regexp);
+    return regexp;
+}
+
+void release_regexp_cache(script_ctx_t *ctx)
+{
+    struct regexp_cache *cache = ctx->regexp_cache;
+    unsigned i;
+
+    if(!cache)
+        return;
+
+    for(i = 0; i < ARRAY_SIZE(cache->entries); i++) {
+        if(cache->entries[i].regexp) {
+            regexp_release(cache->entries[i].regexp);
+            jsstr_release(cache->entries[i].src);
+        }
+    }
+
+    free(cache);
+    ctx->regexp_cache = NULL;
+}
+
 HRESULT create_regexp(script_ctx_t *ctx, jsstr_t *src, DWORD flags, jsdisp_t **ret)
 {
     RegExpInstance *regexp;
+    regexp_t *jsregexp;
     const WCHAR *str;
     HRESULT hres;
 
@@ -636,17 +704,19 @@ HRESULT create_regexp(script_ctx_t *ctx, jsstr_t *src, DWORD flags, jsdisp_t **r
 
     TRACE("%s %lx\n", debugstr_wn(str, jsstr_length(src)), flags);
 
-    hres = alloc_regexp(ctx, src, NULL, &regexp);
-    if(FAILED(hres))
-        return hres;
-
-    regexp->jsregexp = regexp_new(ctx, &ctx->tmp_heap, str, jsstr_length(regexp->str), flags, FALSE);
-    if(!regexp->jsregexp) {
+    jsregexp = compile_regexp(ctx, &src, str, flags);
+    if(!jsregexp) {
         WARN("regexp_new failed\n");
-        jsdisp_release(&regexp->dispex);
         return E_FAIL;
     }
 
+    hres = alloc_regexp(ctx, src, NULL, &regexp);
+    if(FAILED(hres)) {
+        regexp_release(jsregexp);
+        return hres;
+    }
+
+    regexp->jsregexp = jsregexp;
     *ret = &regexp->dispex;
     return S_OK;
 }
@@ -3178,7 +3178,7 @@ HRESULT regexp_execute(regexp_t *regexp, void *cx, heap_pool_t *pool,
     return S_OK;
 }
 
-void regexp_destroy(regexp_t *re)
+static void regexp_destroy(regexp_t *re)
 {
     if (re->classList) {
         UINT i;
@@ -3192,6 +3192,12 @@ void regexp_destroy(regexp_t *re)
     free(re);
 }
 
+void regexp_release(regexp_t *re)
+{
+    if(!--re->ref)
+        regexp_destroy(re);
+}
+
 regexp_t* regexp_new(void *cx, heap_pool_t *pool, const WCHAR *str,
         DWORD str_len, WORD flags, BOOL flat)
 {
@@ -3277,6 +3283,7 @@ regexp_t* regexp_new(void *cx, heap_pool_t *pool, const WCHAR *str,
             re = tmp;
     }
 
+    re->ref = 1;
     re->flags = flags;
     re->parenCount = state.parenCount;
     re->source = str;
@@ -2017,6 +2017,36 @@ ok(tmp, "tmp = " + tmp);
     ok(x === undefined, "x = " + x);
 })();
 
+/* property lookups at the same site must see later changes to the object and its prototype */
+(function() {
+    function C() {}
+    C.prototype.x = 1;
+    C.prototype.f = function() { return "proto"; };
+
+    var o = new C(), i, r = [], c = [];
+    function get(obj) { return obj.x; }
+    function call(obj) { return obj.f(); }
+
+    for(i = 0; i < 7; i++) {
+        switch(i) {
+        case 1: o.x = 2; o.f = function() { return "own"; }; break;
+        case 2: delete o.x; delete o.f; break;
+        case 3: delete C.prototype.x; delete C.prototype.f; break;
+        case 4: C.prototype.x = 3; C.prototype.f = function() { return "new"; }; break;
+        case 5: o = new C(); break;
+        case 6: o = { x: 4, f: function() { return "other"; } }; break;
+        }
+        r.push(get(o));
+        try {
+            c.push(call(o));
+        }catch(e) {
+            c.push("error");
+        }
+    }
+    ok(r.join() === "1,2,1,,3,3,4", "r = " + r.join());
+    ok(c.join() === "proto,own,proto,error,new,new,other", "c = " + c.join());
+})();
+
 var get, set;
 
 /* NoNewline rule parser tests */
@@ -713,4 +713,41 @@ ok(re.ignoreCase === false, "re.ignoreCase = " + re.ignoreCase);
 ok(re.multiline === true, "re.multiline = " + re.multiline);
 ok(re.global === true, "re.global = " + re.global);
 
+/* Compiled regexps are shared by regexps with the same source and flags,
+ * make sure that flags still apply. */
+for(i = 0; i < 2; i++) {
+    ok("xAbA".search(/a/i) === 1, "xAbA.search(/a/i) = " + "xAbA".search(/a/i));
+    ok("xAbA".search(/a/) === -1, "xAbA.search(/a/) = " + "xAbA".search(/a/));
+    ok("xAbA".search(/A/) === 1, "xAbA.search(/A/) = " + "xAbA".search(/A/));
+    tmp = "xAbA".replace(/a/ig, "-");
+    ok(tmp === "x-b-", "xAbA.replace(/a/ig, '-') = " + tmp);
+    ok("xaba".search(new RegExp("A", "i")) === 1, "xaba.search(new RegExp('A', 'i')) failed");
+    ok("xaba".search(new RegExp("A")) === -1, "xaba.search(new RegExp('A')) failed");
+
+    try {
+        re = new RegExp("ab", "gy");
+    }catch(e) {
+        /* sticky flag is not supported by native */
+        re = null;
+    }
+    if(re) {
+        re.lastIndex = 1;
+        m = re.exec("xabab");
+        ok(m !== null && m.index === 1, "m = " + m);
+        ok(re.lastIndex === 3, "re.lastIndex = " + re.lastIndex);
+        m = re.exec("xabab");
+        ok(m !== null && m.index === 3, "m = " + m);
+        re.lastIndex = 0;
+        m = re.exec("xabab");
+        ok(m === null, "m = " + m);
+
+        m = new RegExp("b", "y").exec("ab");
+        ok(m === null, "m = " + m);
+        m = new RegExp("a", "y").exec("ab");
+        ok(m !== null && m.index === 0, "m = " + m);
+        m = new RegExp("b").exec("ab");
+        ok(m !== null && m.index === 1, "m = " + m);
+    }
+}
+
 reportSuccess();
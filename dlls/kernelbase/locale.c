@@ -3817,6 +3817,19 @@ static int get_sortkey( const struct sortguid *sortid, DWORD flags,
 }
 
 
+/* check if a character simply appends its script and primary weights to the primary key,
+ * independently of the characters around it */
+static BOOL is_simple_primary( const struct sortguid *sortid, union char_weights weights, DWORD flags )
+{
+    if (weights._case & CASE_COMPR_6) return FALSE;
+    if (weights.script < SCRIPT_DIGIT) return FALSE;
+    if (weights.script == SCRIPT_DIGIT) return !(flags & SORT_DIGITSASNUMBERS);
+    if (weights.script >= SCRIPT_PUA_FIRST && weights.script <= SCRIPT_PUA_LAST) return FALSE;
+    if ((sortid->flags & FLAG_HAS_3_BYTE_WEIGHTS) &&
+        weights.script >= SCRIPT_CJK_FIRST && weights.script <= SCRIPT_CJK_LAST) return FALSE;
+    return TRUE;
+}
+
 /* implementation of CompareStringEx */
 static int compare_string( const struct sortguid *sortid, DWORD flags,
                            const WCHAR *src1, int srclen1, const WCHAR *src2, int srclen2 )
@@ -3831,12 +3844,28 @@ static int compare_string( const struct sortguid *sortid, DWORD flags,
     UINT except = sortid->except;
     const WCHAR *compr_tables[8];
 
+    if (srclen1 == srclen2 && !memcmp( src1, src2, srclen1 * sizeof(WCHAR) )) return 0;
+
     compr_tables[0] = NULL;
     if (flags & NORM_IGNORECASE) case_mask &= ~(CASE_UPPER | CASE_SUBSCRIPT);
     if (flags & NORM_IGNOREWIDTH) case_mask &= ~CASE_FULLWIDTH;
     if (flags & NORM_IGNOREKANATYPE) case_mask &= ~CASE_KATAKANA;
     if ((flags & NORM_LINGUISTIC_CASING) && except && sortid->ling_except) except = sortid->ling_except;
 
+    /* Primary weights are compared first, so as long as both strings consist of
+     * simple characters the first primary difference decides the result. */
+    for (i = 0; i < srclen1 && i < srclen2; i++)
+    {
+        union char_weights weights1 = get_char_weights( src1[i], except ), weights2;
+
+        if (!is_simple_primary( sortid, weights1, flags )) break;
+        if (src1[i] == src2[i]) continue;
+        weights2 = get_char_weights( src2[i], except );
+        if (!is_simple_primary( sortid, weights2, flags )) break;
+        if (weights1.script != weights2.script) return weights1.script - weights2.script;
+        if (weights1.primary != weights2.primary) return weights1.primary - weights2.primary;
+    }
+
     init_sortkey_state( &s1, flags, srclen1, primary1, sizeof(primary1) );
     init_sortkey_state( &s2, flags, srclen2, primary2, sizeof(primary2) );
 
@@ -3924,8 +3953,13 @@ static int find_substring( const struct sortguid *sortid, DWORD flags, const WCH
                     pos += append_weights( sortid, flags, src, srclen, pos,
                                            case_mask, except, compr_tables, &s, TRUE );
 
-                if (s.primary_pos + s.key_primary.len > val.key_primary.len) goto next;
-                if (memcmp( primary, val.key_primary.buf + s.primary_pos, s.key_primary.len )) goto next;
+                /* longer strings starting here would produce the same mismatch */
+                if (s.primary_pos + s.key_primary.len > val.key_primary.len ||
+                    memcmp( primary, val.key_primary.buf + s.primary_pos, s.key_primary.len ))
+                {
+                    len = srclen;
+                    goto next;
+                }
                 s.primary_pos += s.key_primary.len;
                 s.key_primary.len = 0;
             }
@@ -5778,6 +5778,87 @@ static void test_stringtable(void)
     DeleteFileA(msifile);
 }
 
+static void test_join_duplicate_strings(void)
+{
+    MSIHANDLE hdb, hview, hrec;
+    IStorage *stg;
+    IStream *stm;
+    LARGE_INTEGER pos;
+    char buffer[MAX_PATH], *ptr;
+    const char *query;
+    DWORD size;
+    HRESULT hr;
+    UINT r;
+
+    static const WCHAR stringdata[] = {0x4840, 0x3f3f, 0x4577, 0x446c, 0x3b6a, 0x45e4, 0x4824, 0}; /* _StringData */
+
+    DeleteFileA(msifile);
+
+    r = MsiOpenDatabaseW(msifileW, MSIDBOPEN_CREATE, &hdb);
+    ok(r == ERROR_SUCCESS, "Expected ERROR_SUCCESS, got %d\n", r);
+
+    r = run_query(hdb, 0, "CREATE TABLE `MOO` (`A` INT, `B` CHAR(72) PRIMARY KEY `A`)");
+    ok(r == ERROR_SUCCESS, "Expected ERROR_SUCCESS, got %d\n", r);
+    r = run_query(hdb, 0, "CREATE TABLE `AAR` (`C` INT, `D` CHAR(72) PRIMARY KEY `C`)");
+    ok(r == ERROR_SUCCESS, "Expected ERROR_SUCCESS, got %d\n", r);
+    r = run_query(hdb, 0, "INSERT INTO `MOO` (`A`, `B`) VALUES (1, 'one')");
+    ok(r == ERROR_SUCCESS, "Expected ERROR_SUCCESS, got %d\n", r);
+    r = run_query(hdb, 0, "INSERT INTO `AAR` (`C`, `D`) VALUES (2, 'two')");
+    ok(r == ERROR_SUCCESS, "Expected ERROR_SUCCESS, got %d\n", r);
+
+    r = MsiDatabaseCommit(hdb);
+    ok(r == ERROR_SUCCESS, "Expected ERROR_SUCCESS, got %d\n", r);
+    MsiCloseHandle(hdb);
+
+    /* turn 'two' into a second copy of 'one' in the stored string pool */
+    hr = StgOpenStorage(msifileW, NULL, STGM_DIRECT | STGM_READWRITE | STGM_SHARE_EXCLUSIVE, NULL, 0, &stg);
+    ok(hr == S_OK, "Expected S_OK, got %#lx\n", hr);
+    hr = IStorage_OpenStream(stg, stringdata, NULL, STGM_READWRITE | STGM_SHARE_EXCLUSIVE, 0, &stm);
+    ok(hr == S_OK, "Expected S_OK, got %#lx\n", hr);
+
+    memset(buffer, 0, sizeof(buffer));
+    hr = IStream_Read(stm, buffer, sizeof(buffer) - 1, &size);
+    ok(hr == S_OK, "Expected S_OK, got %#lx\n", hr);
+    ptr = strstr(buffer, "two");
+    ok(ptr != NULL, "string not found\n");
+    if (ptr)
+    {
+        pos.QuadPart = ptr - buffer;
+        hr = IStream_Seek(stm, pos, STREAM_SEEK_SET, NULL);
+        ok(hr == S_OK, "Expected S_OK, got %#lx\n", hr);
+        hr = IStream_Write(stm, "one", 3, &size);
+        ok(hr == S_OK, "Expected S_OK, got %#lx\n", hr);
+    }
+
+    IStream_Release(stm);
+    IStorage_Release(stg);
+
+    r = MsiOpenDatabaseW(msifileW, MSIDBOPEN_READONLY, &hdb);
+    ok(r == ERROR_SUCCESS, "Expected ERROR_SUCCESS, got %d\n", r);
+
+    query = "SELECT `A`, `C` FROM `MOO`, `AAR` WHERE `B` = `D`";
+    r = MsiDatabaseOpenViewA(hdb, query, &hview);
+    ok(r == ERROR_SUCCESS, "Expected ERROR_SUCCESS, got %d\n", r);
+    r = MsiViewExecute(hview, 0);
+    ok(r == ERROR_SUCCESS, "Expected ERROR_SUCCESS, got %d\n", r);
+
+    r = MsiViewFetch(hview, &hrec);
+    ok(r == ERROR_SUCCESS, "Expected ERROR_SUCCESS, got %d\n", r);
+    if (r == ERROR_SUCCESS)
+    {
+        check_record(hrec, 2, "1", "2");
+        MsiCloseHandle(hrec);
+    }
+
+    r = MsiViewFetch(hview, &hrec);
+    ok(r == ERROR_NO_MORE_ITEMS, "Expected ERROR_NO_MORE_ITEMS, got %d\n", r);
+
+    MsiViewClose(hview);
+    MsiCloseHandle(hview);
+    MsiCloseHandle(hdb);
+    DeleteFileA(msifile);
+}
+
 static void test_viewmodify_delete(void)
 {
     MSIHANDLE hdb = 0, hview = 0, hrec = 0;
@@ -9408,6 +9489,7 @@ START_TEST(db)
     test_viewmodify_update();
     test_viewmodify_assign();
     test_stringtable();
+    test_join_duplicate_strings();
     test_viewmodify_delete();
     test_defaultdatabase();
     test_order();
@@ -51,6 +51,12 @@ typedef struct tagJOINTABLE
     UINT col_count;
     UINT row_count;
     UINT table_index;
+    /* hash index over join_col, built while executing a join */
+    const struct expr *join_col;
+    const struct expr *join_key;
+    UINT *join_values;
+    UINT *join_next;
+    UINT *join_buckets;
 } JOINTABLE;
 
 typedef struct tagMSIORDERINFO
@@ -647,16 +653,197 @@ static UINT WHERE_evaluate( MSIWHEREVIEW *wv, const UINT rows[],
     return ERROR_SUCCESS;
 }
 
+static BOOL table_bound_before( JOINTABLE **ordered_tables, const JOINTABLE *bound,
+                                const JOINTABLE *table )
+{
+    for (; *ordered_tables != table; ordered_tables++)
+        if (*ordered_tables == bound) return TRUE;
+    return FALSE;
+}
+
+static BOOL is_join_pair( JOINTABLE **ordered_tables, JOINTABLE *table,
+                          const struct expr *col, const struct expr *key )
+{
+    return col->u.column.parsed.table == table &&
+           table_bound_before( ordered_tables, key->u.column.parsed.table, table );
+}
+
+/* look for a top level "column = column" condition joining table to an outer table */
+static BOOL find_join( const struct expr *cond, JOINTABLE **ordered_tables, JOINTABLE *table )
+{
+    const struct expr *left, *right;
+
+    if (cond->type == EXPR_COMPLEX && cond->u.expr.op == OP_AND)
+        return find_join( cond->u.expr.left, ordered_tables, table ) ||
+               find_join( cond->u.expr.right, ordered_tables, table );
+
+    if ((cond->type != EXPR_COMPLEX && cond->type != EXPR_STRCMP) || cond->u.expr.op != OP_EQ)
+        return FALSE;
+
+    left = cond->u.expr.left;
+    right = cond->u.expr.right;
+    if (cond->type == EXPR_STRCMP)
+    {
+        if (left->type != EXPR_COL_NUMBER_STRING || right->type != EXPR_COL_NUMBER_STRING)
+            return FALSE;
+    }
+    else if ((left->type != EXPR_COL_NUMBER && left->type != EXPR_COL_NUMBER32) ||
+             (right->type != EXPR_COL_NUMBER && right->type != EXPR_COL_NUMBER32))
+        return FALSE;
+
+    if (is_join_pair( ordered_tables, table, left, right ))
+    {
+        table->join_col = left;
+        table->join_key = right;
+        return TRUE;
+    }
+    if (is_join_pair( ordered_tables, table, right, left ))
+    {
+        table->join_col = right;
+        table->join_key = left;
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static inline UINT column_bias( const struct expr *col )
+{
+    switch (col->type)
+    {
+    case EXPR_COL_NUMBER:   return 0x8000;
+    case EXPR_COL_NUMBER32: return 0x80000000;
+    default:                return 0;
+    }
+}
+
+static void free_join_index( JOINTABLE *table )
+{
+    free( table->join_values );
+    table->join_values = table->join_next = table->join_buckets = NULL;
+    table->join_col = table->join_key = NULL;
+}
+
+/* string pools loaded from disk may hold the same string under several ids,
+ * so string keys are hashed and compared by contents */
+static UINT join_key_hash( const MSIWHEREVIEW *wv, const JOINTABLE *table, UINT value )
+{
+    const WCHAR *str;
+    UINT hash = 0;
+
+    if (table->join_col->type != EXPR_COL_NUMBER_STRING)
+        return value;
+    if ((str = msi_string_lookup( wv->db->strings, value, NULL )))
+        while (*str) hash = hash * 31 + *str++;
+    return hash;
+}
+
+static BOOL join_keys_equal( const MSIWHEREVIEW *wv, const JOINTABLE *table, UINT value, UINT key )
+{
+    const WCHAR *str1, *str2;
+
+    if (value == key)
+        return TRUE;
+    if (table->join_col->type != EXPR_COL_NUMBER_STRING)
+        return FALSE;
+    str1 = msi_string_lookup( wv->db->strings, value, NULL );
+    str2 = msi_string_lookup( wv->db->strings, key, NULL );
+    return str1 && str2 && !wcscmp( str1, str2 );
+}
+
+static void build_join_index( MSIWHEREVIEW *wv, JOINTABLE **ordered_tables, JOINTABLE *table )
+{
+    UINT i, r, hash;
+
+    if (!wv->cond || !find_join( wv->cond, ordered_tables, table ))
+        return;
+
+    TRACE("hash join on column %u of table %u\n", table->join_col->u.column.parsed.column,
+          table->table_index);
+
+    if (!(table->join_values = malloc( 3 * table->row_count * sizeof(UINT) )))
+    {
+        free_join_index( table );
+        return;
+    }
+    table->join_next = table->join_values + table->row_count;
+    table->join_buckets = table->join_next + table->row_count;
+    for (i = 0; i < table->row_count; i++)
+        table->join_buckets[i] = INVALID_ROW_INDEX;
+
+    /* insert backwards so that each chain is in ascending row order */
+    for (i = table->row_count; i-- > 0;)
+    {
+        r = table->view->ops->fetch_int( table->view, i, table->join_col->u.column.parsed.column,
+                                         &table->join_values[i] );
+        if (r != ERROR_SUCCESS)
+        {
+            free_join_index( table );
+            return;
+        }
+        hash = join_key_hash( wv, table, table->join_values[i] ) % table->row_count;
+        table->join_next[i] = table->join_buckets[hash];
+        table->join_buckets[hash] = i;
+    }
+}
+
+static UINT join_next_match( const MSIWHEREVIEW *wv, const JOINTABLE *table, UINT row, UINT key )
+{
+    while (row != INVALID_ROW_INDEX && !join_keys_equal( wv, table, table->join_values[row], key ))
+        row = table->join_next[row];
+    return row;
+}
+
+/* returns the first row of table that may satisfy the condition; *scan is set
+ * if all rows have to be checked */
+static UINT join_first_row( MSIWHEREVIEW *wv, const JOINTABLE *table, const UINT rows[], BOOL *scan )
+{
+    const JOINTABLE *outer;
+    const WCHAR *str;
+    UINT key, hash;
+
+    *scan = TRUE;
+    if (!table->join_buckets)
+        return 0;
+
+    outer = table->join_key->u.column.parsed.table;
+    if (outer->view->ops->fetch_int( outer->view, rows[outer->table_index],
+                                     table->join_key->u.column.parsed.column, &key ) != ERROR_SUCCESS)
+        return 0;
+
+    if (table->join_key->type == EXPR_COL_NUMBER_STRING)
+    {
+        /* null and empty strings compare equal, leave them to the full scan */
+        str = msi_string_lookup( wv->db->strings, key, NULL );
+        if (!str || !*str)
+            return 0;
+    }
+    else
+        key = key - column_bias( table->join_key ) + column_bias( table->join_col );
+
+    *scan = FALSE;
+    hash = join_key_hash( wv, table, key ) % table->row_count;
+    return join_next_match( wv, table, table->join_buckets[hash], key );
+}
+
+static UINT join_next_row( const MSIWHEREVIEW *wv, const JOINTABLE *table, UINT row, BOOL scan )
+{
+    if (scan)
+        return row + 1 < table->row_count ? row + 1 : INVALID_ROW_INDEX;
+    return join_next_match( wv, table, table->join_next[row], table->join_values[row] );
+}
+
 static UINT check_condition( MSIWHEREVIEW *wv, MSIRECORD *record, JOINTABLE **tables,
                              UINT table_rows[] )
 {
-    UINT r = ERROR_FUNCTION_FAILED;
+    UINT r = ERROR_SUCCESS, row;
+    BOOL scan;
     INT val;
 
-    for (table_rows[(*tables)->table_index] = 0;
-         table_rows[(*tables)->table_index] < (*tables)->row_count;
-         table_rows[(*tables)->table_index]++)
+    for (row = join_first_row(wv, *tables, table_rows, &scan);
+         row != INVALID_ROW_INDEX;
+         row = join_next_row(wv, *tables, row, scan))
     {
+        table_rows[(*tables)->table_index] = row;
         val = 0;
         wv->rec_index = 0;
         r = WHERE_evaluate( wv, table_rows, wv->cond, &val, record );
@@ -848,12 +1035,20 @@ static UINT WHERE_execute( struct tagMSIVIEW *view, MSIRECORD *record )
 
     ordered_tables = ordertables( wv );
 
+    /* joined tables are looked up through a hash index instead of being scanned
+     * once for every row combination of the outer tables */
+    for (i = 1; i < wv->table_count; i++)
+        build_join_index( wv, ordered_tables, ordered_tables[i] );
+
     rows = malloc(wv->table_count * sizeof(*rows));
     for (i = 0; i < wv->table_count; i++)
         rows[i] = INVALID_ROW_INDEX;
 
     r =  check_condition(wv, record, ordered_tables, rows);
 
+    for (i = 1; i < wv->table_count; i++)
+        free_join_index( ordered_tables[i] );
+
     if (wv->order_info)
         wv->order_info->error = ERROR_SUCCESS;
 
@@ -1250,7 +1445,7 @@ UINT WHERE_CreateView( MSIDATABASE *db, MSIVIEW **view, LPWSTR tables,
         if ((ptr = wcschr(tables, ' ')))
             *ptr = '\0';
 
-        table = malloc(sizeof(JOINTABLE));
+        table = calloc(1, sizeof(JOINTABLE));
         if (!table)
         {
             r = ERROR_OUTOFMEMORY;
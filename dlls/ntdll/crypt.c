@@ -21,6 +21,11 @@
 #include <stdarg.h>
 #include "windef.h"
 
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <intrin.h>
+#define HAVE_SHA_NI
+#endif
+
 /* SHA1 algorithm
  *
  * Based on public domain SHA code by Steve Reid <steve@edmweb.com>
@@ -98,6 +103,74 @@ static void SHA1Transform(ULONG State[5], UCHAR Buffer[64])
    a = b = c = d = e = 0;
 }
 
+#ifdef HAVE_SHA_NI
+
+static BOOL have_sha_ni(void)
+{
+   static int supported = -1;
+   int regs[4];
+
+   if (supported == -1)
+   {
+      supported = 0;
+      __cpuid(regs, 0);
+      if (regs[0] >= 7)
+      {
+         __cpuid(regs, 1);
+         if ((regs[2] & (1 << 9)) && (regs[2] & (1 << 19)))  /* SSSE3 and SSE4.1 */
+         {
+            __cpuidex(regs, 7, 0);
+            supported = !!(regs[1] & (1 << 29));  /* SHA */
+         }
+      }
+   }
+   return supported;
+}
+
+/* Hash 512-bit blocks using the SHA extensions. Unlike SHA1Transform, the input is left untouched. */
+static void __attribute__((target("sha,sse4.1"))) SHA1TransformNI(ULONG State[5], const UCHAR *Buffer, SIZE_T Count)
+{
+   const __m128i mask = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+   __m128i abcd, e0, e1, abcd_save, e_save, msg[4];
+   int i;
+
+   abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)State), 0x1b);
+   e0 = _mm_set_epi32(State[4], 0, 0, 0);
+
+   for (; Count; Count--, Buffer += 64)
+   {
+      abcd_save = abcd;
+      e_save = e0;
+
+      /* 20 groups of 4 rounds, the message schedule runs 4 vectors ahead */
+      for (i = 0; i < 20; i++)
+      {
+         if (i < 4)
+            msg[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(Buffer + 16 * i)), mask);
+         else
+            msg[i & 3] = _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(msg[i & 3], msg[(i + 1) & 3]),
+                                                          msg[(i + 2) & 3]), msg[(i + 3) & 3]);
+         e1 = i ? _mm_sha1nexte_epu32(e0, msg[i & 3]) : _mm_add_epi32(e0, msg[0]);
+         e0 = abcd;
+         switch (i / 5)
+         {
+         case 0: abcd = _mm_sha1rnds4_epu32(abcd, e1, 0); break;
+         case 1: abcd = _mm_sha1rnds4_epu32(abcd, e1, 1); break;
+         case 2: abcd = _mm_sha1rnds4_epu32(abcd, e1, 2); break;
+         case 3: abcd = _mm_sha1rnds4_epu32(abcd, e1, 3); break;
+         }
+      }
+
+      e0 = _mm_sha1nexte_epu32(e0, e_save);
+      abcd = _mm_add_epi32(abcd, abcd_save);
+   }
+
+   _mm_storeu_si128((__m128i *)State, _mm_shuffle_epi32(abcd, 0x1b));
+   State[4] = _mm_extract_epi32(e0, 3);
+}
+
+#endif /* HAVE_SHA_NI */
+
 
 /******************************************************************************
  * A_SHAInit (ntdll.@)
@@ -152,6 +225,22 @@ void WINAPI A_SHAUpdate(PSHA_CTX Context, const unsigned char *Buffer, UINT Buff
    }
    else
    {
+#ifdef HAVE_SHA_NI
+      if (have_sha_ni())
+      {
+         if (BufferContentSize)
+         {
+            RtlCopyMemory(Context->Buffer + BufferContentSize, Buffer, 64 - BufferContentSize);
+            Buffer += 64 - BufferContentSize;
+            BufferSize -= 64 - BufferContentSize;
+            SHA1TransformNI(Context->State, Context->Buffer, 1);
+         }
+         /* full blocks are hashed in place */
+         SHA1TransformNI(Context->State, Buffer, BufferSize / 64);
+         RtlCopyMemory(Context->Buffer, Buffer + (BufferSize & ~63), BufferSize & 63);
+         return;
+      }
+#endif
       while (BufferContentSize + BufferSize >= 64)
       {
          RtlCopyMemory(Context->Buffer + BufferContentSize, Buffer,
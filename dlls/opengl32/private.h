@@ -28,8 +28,30 @@
 #include "winternl.h"
 #include "wingdi.h"
 
+#include "wine/unixlib.h"
+
 extern const void *extension_procs[] DECLSPEC_HIDDEN;
 
+#define GL_BATCH_SIZE 0x4000
+
+/* per-thread queue of deferred calls, stored in TEB glReserved2 */
+struct gl_batch
+{
+    UINT size;
+    BOOL flushing;
+    BYTE data[GL_BATCH_SIZE] DECLSPEC_ALIGN(8);
+};
+
+extern void queue_gl_call( UINT code, const void *args, UINT size ) DECLSPEC_HIDDEN;
+extern void flush_gl_batch( struct gl_batch *batch ) DECLSPEC_HIDDEN;
+
+static inline NTSTATUS gl_unix_call( UINT code, void *args )
+{
+    struct gl_batch *batch = NtCurrentTeb()->glReserved2;
+    if (batch && batch->size && !batch->flushing) flush_gl_batch( batch );
+    return WINE_UNIX_CALL( code, args );
+}
+
 extern int WINAPI wglDescribePixelFormat( HDC hdc, int ipfd, UINT cjpfd, PIXELFORMATDESCRIPTOR *ppfd );
 
 #endif /* __WINE_OPENGL32_PRIVATE_H */
@@ -115,9 +115,8 @@ void WINAPI glArrayElement( GLint i )
 void WINAPI glBegin( GLenum mode )
 {
     struct glBegin_params args = { .teb = NtCurrentTeb(), .mode = mode };
-    NTSTATUS status;
     TRACE( "mode %d\n", mode );
-    if ((status = UNIX_CALL( glBegin, &args ))) WARN( "glBegin returned %#lx\n", status );
+    queue_gl_call( unix_glBegin, &args, sizeof(args) );
 }
 
 void WINAPI glBindTexture( GLenum target, GLuint texture )
@@ -219,9 +218,8 @@ void WINAPI glClipPlane( GLenum plane, const GLdouble *equation )
 void WINAPI glColor3b( GLbyte red, GLbyte green, GLbyte blue )
 {
     struct glColor3b_params args = { .teb = NtCurrentTeb(), .red = red, .green = green, .blue = blue };
-    NTSTATUS status;
     TRACE( "red %d, green %d, blue %d\n", red, green, blue );
-    if ((status = UNIX_CALL( glColor3b, &args ))) WARN( "glColor3b returned %#lx\n", status );
+    queue_gl_call( unix_glColor3b, &args, sizeof(args) );
 }
 
 void WINAPI glColor3bv( const GLbyte *v )
@@ -235,9 +233,8 @@ void WINAPI glColor3bv( const GLbyte *v )
 void WINAPI glColor3d( GLdouble red, GLdouble green, GLdouble blue )
 {
     struct glColor3d_params args = { .teb = NtCurrentTeb(), .red = red, .green = green, .blue = blue };
-    NTSTATUS status;
     TRACE( "red %f, green %f, blue %f\n", red, green, blue );
-    if ((status = UNIX_CALL( glColor3d, &args ))) WARN( "glColor3d returned %#lx\n", status );
+    queue_gl_call( unix_glColor3d, &args, sizeof(args) );
 }
 
 void WINAPI glColor3dv( const GLdouble *v )
@@ -251,9 +248,8 @@ void WINAPI glColor3dv( const GLdouble *v )
 void WINAPI glColor3f( GLfloat red, GLfloat green, GLfloat blue )
 {
     struct glColor3f_params args = { .teb = NtCurrentTeb(), .red = red, .green = green, .blue = blue };
-    NTSTATUS status;
     TRACE( "red %f, green %f, blue %f\n", red, green, blue );
-    if ((status = UNIX_CALL( glColor3f, &args ))) WARN( "glColor3f returned %#lx\n", status );
+    queue_gl_call( unix_glColor3f, &args, sizeof(args) );
 }
 
 void WINAPI glColor3fv( const GLfloat *v )
@@ -267,9 +263,8 @@ void WINAPI glColor3fv( const GLfloat *v )
 void WINAPI glColor3i( GLint red, GLint green, GLint blue )
 {
     struct glColor3i_params args = { .teb = NtCurrentTeb(), .red = red, .green = green, .blue = blue };
-    NTSTATUS status;
     TRACE( "red %d, green %d, blue %d\n", red, green, blue );
-    if ((status = UNIX_CALL( glColor3i, &args ))) WARN( "glColor3i returned %#lx\n", status );
+    queue_gl_call( unix_glColor3i, &args, sizeof(args) );
 }
 
 void WINAPI glColor3iv( const GLint *v )
@@ -283,9 +278,8 @@ void WINAPI glColor3iv( const GLint *v )
 void WINAPI glColor3s( GLshort red, GLshort green, GLshort blue )
 {
     struct glColor3s_params args = { .teb = NtCurrentTeb(), .red = red, .green = green, .blue = blue };
-    NTSTATUS status;
     TRACE( "red %d, green %d, blue %d\n", red, green, blue );
-    if ((status = UNIX_CALL( glColor3s, &args ))) WARN( "glColor3s returned %#lx\n", status );
+    queue_gl_call( unix_glColor3s, &args, sizeof(args) );
 }
 
 void WINAPI glColor3sv( const GLshort *v )
@@ -299,9 +293,8 @@ void WINAPI glColor3sv( const GLshort *v )
 void WINAPI glColor3ub( GLubyte red, GLubyte green, GLubyte blue )
 {
     struct glColor3ub_params args = { .teb = NtCurrentTeb(), .red = red, .green = green, .blue = blue };
-    NTSTATUS status;
     TRACE( "red %d, green %d, blue %d\n", red, green, blue );
-    if ((status = UNIX_CALL( glColor3ub, &args ))) WARN( "glColor3ub returned %#lx\n", status );
+    queue_gl_call( unix_glColor3ub, &args, sizeof(args) );
 }
 
 void WINAPI glColor3ubv( const GLubyte *v )
@@ -315,9 +308,8 @@ void WINAPI glColor3ubv( const GLubyte *v )
 void WINAPI glColor3ui( GLuint red, GLuint green, GLuint blue )
 {
     struct glColor3ui_params args = { .teb = NtCurrentTeb(), .red = red, .green = green, .blue = blue };
-    NTSTATUS status;
     TRACE( "red %d, green %d, blue %d\n", red, green, blue );
-    if ((status = UNIX_CALL( glColor3ui, &args ))) WARN( "glColor3ui returned %#lx\n", status );
+    queue_gl_call( unix_glColor3ui, &args, sizeof(args) );
 }
 
 void WINAPI glColor3uiv( const GLuint *v )
@@ -331,9 +323,8 @@ void WINAPI glColor3uiv( const GLuint *v )
 void WINAPI glColor3us( GLushort red, GLushort green, GLushort blue )
 {
     struct glColor3us_params args = { .teb = NtCurrentTeb(), .red = red, .green = green, .blue = blue };
-    NTSTATUS status;
     TRACE( "red %d, green %d, blue %d\n", red, green, blue );
-    if ((status = UNIX_CALL( glColor3us, &args ))) WARN( "glColor3us returned %#lx\n", status );
+    queue_gl_call( unix_glColor3us, &args, sizeof(args) );
 }
 
 void WINAPI glColor3usv( const GLushort *v )
@@ -347,9 +338,8 @@ void WINAPI glColor3usv( const GLushort *v )
 void WINAPI glColor4b( GLbyte red, GLbyte green, GLbyte blue, GLbyte alpha )
 {
     struct glColor4b_params args = { .teb = NtCurrentTeb(), .red = red, .green = green, .blue = blue, .alpha = alpha };
-    NTSTATUS status;
     TRACE( "red %d, green %d, blue %d, alpha %d\n", red, green, blue, alpha );
-    if ((status = UNIX_CALL( glColor4b, &args ))) WARN( "glColor4b returned %#lx\n", status );
+    queue_gl_call( unix_glColor4b, &args, sizeof(args) );
 }
 
 void WINAPI glColor4bv( const GLbyte *v )
@@ -363,9 +353,8 @@ void WINAPI glColor4bv( const GLbyte *v )
 void WINAPI glColor4d( GLdouble red, GLdouble green, GLdouble blue, GLdouble alpha )
 {
     struct glColor4d_params args = { .teb = NtCurrentTeb(), .red = red, .green = green, .blue = blue, .alpha = alpha };
-    NTSTATUS status;
     TRACE( "red %f, green %f, blue %f, alpha %f\n", red, green, blue, alpha );
-    if ((status = UNIX_CALL( glColor4d, &args ))) WARN( "glColor4d returned %#lx\n", status );
+    queue_gl_call( unix_glColor4d, &args, sizeof(args) );
 }
 
 void WINAPI glColor4dv( const GLdouble *v )
@@ -379,9 +368,8 @@ void WINAPI glColor4dv( const GLdouble *v )
 void WINAPI glColor4f( GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha )
 {
     struct glColor4f_params args = { .teb = NtCurrentTeb(), .red = red, .green = green, .blue = blue, .alpha = alpha };
-    NTSTATUS status;
     TRACE( "red %f, green %f, blue %f, alpha %f\n", red, green, blue, alpha );
-    if ((status = UNIX_CALL( glColor4f, &args ))) WARN( "glColor4f returned %#lx\n", status );
+    queue_gl_call( unix_glColor4f, &args, sizeof(args) );
 }
 
 void WINAPI glColor4fv( const GLfloat *v )
@@ -395,9 +383,8 @@ void WINAPI glColor4fv( const GLfloat *v )
 void WINAPI glColor4i( GLint red, GLint green, GLint blue, GLint alpha )
 {
     struct glColor4i_params args = { .teb = NtCurrentTeb(), .red = red, .green = green, .blue = blue, .alpha = alpha };
-    NTSTATUS status;
     TRACE( "red %d, green %d, blue %d, alpha %d\n", red, green, blue, alpha );
-    if ((status = UNIX_CALL( glColor4i, &args ))) WARN( "glColor4i returned %#lx\n", status );
+    queue_gl_call( unix_glColor4i, &args, sizeof(args) );
 }
 
 void WINAPI glColor4iv( const GLint *v )
@@ -411,9 +398,8 @@ void WINAPI glColor4iv( const GLint *v )
 void WINAPI glColor4s( GLshort red, GLshort green, GLshort blue, GLshort alpha )
 {
     struct glColor4s_params args = { .teb = NtCurrentTeb(), .red = red, .green = green, .blue = blue, .alpha = alpha };
-    NTSTATUS status;
     TRACE( "red %d, green %d, blue %d, alpha %d\n", red, green, blue, alpha );
-    if ((status = UNIX_CALL( glColor4s, &args ))) WARN( "glColor4s returned %#lx\n", status );
+    queue_gl_call( unix_glColor4s, &args, sizeof(args) );
 }
 
 void WINAPI glColor4sv( const GLshort *v )
@@ -427,9 +413,8 @@ void WINAPI glColor4sv( const GLshort *v )
 void WINAPI glColor4ub( GLubyte red, GLubyte green, GLubyte blue, GLubyte alpha )
 {
     struct glColor4ub_params args = { .teb = NtCurrentTeb(), .red = red, .green = green, .blue = blue, .alpha = alpha };
-    NTSTATUS status;
     TRACE( "red %d, green %d, blue %d, alpha %d\n", red, green, blue, alpha );
-    if ((status = UNIX_CALL( glColor4ub, &args ))) WARN( "glColor4ub returned %#lx\n", status );
+    queue_gl_call( unix_glColor4ub, &args, sizeof(args) );
 }
 
 void WINAPI glColor4ubv( const GLubyte *v )
@@ -443,9 +428,8 @@ void WINAPI glColor4ubv( const GLubyte *v )
 void WINAPI glColor4ui( GLuint red, GLuint green, GLuint blue, GLuint alpha )
 {
     struct glColor4ui_params args = { .teb = NtCurrentTeb(), .red = red, .green = green, .blue = blue, .alpha = alpha };
-    NTSTATUS status;
     TRACE( "red %d, green %d, blue %d, alpha %d\n", red, green, blue, alpha );
-    if ((status = UNIX_CALL( glColor4ui, &args ))) WARN( "glColor4ui returned %#lx\n", status );
+    queue_gl_call( unix_glColor4ui, &args, sizeof(args) );
 }
 
 void WINAPI glColor4uiv( const GLuint *v )
@@ -459,9 +443,8 @@ void WINAPI glColor4uiv( const GLuint *v )
 void WINAPI glColor4us( GLushort red, GLushort green, GLushort blue, GLushort alpha )
 {
     struct glColor4us_params args = { .teb = NtCurrentTeb(), .red = red, .green = green, .blue = blue, .alpha = alpha };
-    NTSTATUS status;
     TRACE( "red %d, green %d, blue %d, alpha %d\n", red, green, blue, alpha );
-    if ((status = UNIX_CALL( glColor4us, &args ))) WARN( "glColor4us returned %#lx\n", status );
+    queue_gl_call( unix_glColor4us, &args, sizeof(args) );
 }
 
 void WINAPI glColor4usv( const GLushort *v )
@@ -675,9 +658,8 @@ void WINAPI glEnableClientState( GLenum array )
 void WINAPI glEnd(void)
 {
     struct glEnd_params args = { .teb = NtCurrentTeb() };
-    NTSTATUS status;
     TRACE( "\n" );
-    if ((status = UNIX_CALL( glEnd, &args ))) WARN( "glEnd returned %#lx\n", status );
+    queue_gl_call( unix_glEnd, &args, sizeof(args) );
 }
 
 void WINAPI glEndList(void)
@@ -1125,9 +1107,8 @@ void WINAPI glIndexPointer( GLenum type, GLsizei stride, const void *pointer )
 void WINAPI glIndexd( GLdouble c )
 {
     struct glIndexd_params args = { .teb = NtCurrentTeb(), .c = c };
-    NTSTATUS status;
     TRACE( "c %f\n", c );
-    if ((status = UNIX_CALL( glIndexd, &args ))) WARN( "glIndexd returned %#lx\n", status );
+    queue_gl_call( unix_glIndexd, &args, sizeof(args) );
 }
 
 void WINAPI glIndexdv( const GLdouble *c )
@@ -1141,9 +1122,8 @@ void WINAPI glIndexdv( const GLdouble *c )
 void WINAPI glIndexf( GLfloat c )
 {
     struct glIndexf_params args = { .teb = NtCurrentTeb(), .c = c };
-    NTSTATUS status;
     TRACE( "c %f\n", c );
-    if ((status = UNIX_CALL( glIndexf, &args ))) WARN( "glIndexf returned %#lx\n", status );
+    queue_gl_call( unix_glIndexf, &args, sizeof(args) );
 }
 
 void WINAPI glIndexfv( const GLfloat *c )
@@ -1157,9 +1137,8 @@ void WINAPI glIndexfv( const GLfloat *c )
 void WINAPI glIndexi( GLint c )
 {
     struct glIndexi_params args = { .teb = NtCurrentTeb(), .c = c };
-    NTSTATUS status;
     TRACE( "c %d\n", c );
-    if ((status = UNIX_CALL( glIndexi, &args ))) WARN( "glIndexi returned %#lx\n", status );
+    queue_gl_call( unix_glIndexi, &args, sizeof(args) );
 }
 
 void WINAPI glIndexiv( const GLint *c )
@@ -1173,9 +1152,8 @@ void WINAPI glIndexiv( const GLint *c )
 void WINAPI glIndexs( GLshort c )
 {
     struct glIndexs_params args = { .teb = NtCurrentTeb(), .c = c };
-    NTSTATUS status;
     TRACE( "c %d\n", c );
-    if ((status = UNIX_CALL( glIndexs, &args ))) WARN( "glIndexs returned %#lx\n", status );
+    queue_gl_call( unix_glIndexs, &args, sizeof(args) );
 }
 
 void WINAPI glIndexsv( const GLshort *c )
@@ -1189,9 +1167,8 @@ void WINAPI glIndexsv( const GLshort *c )
 void WINAPI glIndexub( GLubyte c )
 {
     struct glIndexub_params args = { .teb = NtCurrentTeb(), .c = c };
-    NTSTATUS status;
     TRACE( "c %d\n", c );
-    if ((status = UNIX_CALL( glIndexub, &args ))) WARN( "glIndexub returned %#lx\n", status );
+    queue_gl_call( unix_glIndexub, &args, sizeof(args) );
 }
 
 void WINAPI glIndexubv( const GLubyte *c )
@@ -1504,9 +1481,8 @@ void WINAPI glNewList( GLuint list, GLenum mode )
 void WINAPI glNormal3b( GLbyte nx, GLbyte ny, GLbyte nz )
 {
     struct glNormal3b_params args = { .teb = NtCurrentTeb(), .nx = nx, .ny = ny, .nz = nz };
-    NTSTATUS status;
     TRACE( "nx %d, ny %d, nz %d\n", nx, ny, nz );
-    if ((status = UNIX_CALL( glNormal3b, &args ))) WARN( "glNormal3b returned %#lx\n", status );
+    queue_gl_call( unix_glNormal3b, &args, sizeof(args) );
 }
 
 void WINAPI glNormal3bv( const GLbyte *v )
@@ -1520,9 +1496,8 @@ void WINAPI glNormal3bv( const GLbyte *v )
 void WINAPI glNormal3d( GLdouble nx, GLdouble ny, GLdouble nz )
 {
     struct glNormal3d_params args = { .teb = NtCurrentTeb(), .nx = nx, .ny = ny, .nz = nz };
-    NTSTATUS status;
     TRACE( "nx %f, ny %f, nz %f\n", nx, ny, nz );
-    if ((status = UNIX_CALL( glNormal3d, &args ))) WARN( "glNormal3d returned %#lx\n", status );
+    queue_gl_call( unix_glNormal3d, &args, sizeof(args) );
 }
 
 void WINAPI glNormal3dv( const GLdouble *v )
@@ -1536,9 +1511,8 @@ void WINAPI glNormal3dv( const GLdouble *v )
 void WINAPI glNormal3f( GLfloat nx, GLfloat ny, GLfloat nz )
 {
     struct glNormal3f_params args = { .teb = NtCurrentTeb(), .nx = nx, .ny = ny, .nz = nz };
-    NTSTATUS status;
     TRACE( "nx %f, ny %f, nz %f\n", nx, ny, nz );
-    if ((status = UNIX_CALL( glNormal3f, &args ))) WARN( "glNormal3f returned %#lx\n", status );
+    queue_gl_call( unix_glNormal3f, &args, sizeof(args) );
 }
 
 void WINAPI glNormal3fv( const GLfloat *v )
@@ -1552,9 +1526,8 @@ void WINAPI glNormal3fv( const GLfloat *v )
 void WINAPI glNormal3i( GLint nx, GLint ny, GLint nz )
 {
     struct glNormal3i_params args = { .teb = NtCurrentTeb(), .nx = nx, .ny = ny, .nz = nz };
-    NTSTATUS status;
     TRACE( "nx %d, ny %d, nz %d\n", nx, ny, nz );
-    if ((status = UNIX_CALL( glNormal3i, &args ))) WARN( "glNormal3i returned %#lx\n", status );
+    queue_gl_call( unix_glNormal3i, &args, sizeof(args) );
 }
 
 void WINAPI glNormal3iv( const GLint *v )
@@ -1568,9 +1541,8 @@ void WINAPI glNormal3iv( const GLint *v )
 void WINAPI glNormal3s( GLshort nx, GLshort ny, GLshort nz )
 {
     struct glNormal3s_params args = { .teb = NtCurrentTeb(), .nx = nx, .ny = ny, .nz = nz };
-    NTSTATUS status;
     TRACE( "nx %d, ny %d, nz %d\n", nx, ny, nz );
-    if ((status = UNIX_CALL( glNormal3s, &args ))) WARN( "glNormal3s returned %#lx\n", status );
+    queue_gl_call( unix_glNormal3s, &args, sizeof(args) );
 }
 
 void WINAPI glNormal3sv( const GLshort *v )
@@ -2137,9 +2109,8 @@ void WINAPI glStencilOp( GLenum fail, GLenum zfail, GLenum zpass )
 void WINAPI glTexCoord1d( GLdouble s )
 {
     struct glTexCoord1d_params args = { .teb = NtCurrentTeb(), .s = s };
-    NTSTATUS status;
     TRACE( "s %f\n", s );
-    if ((status = UNIX_CALL( glTexCoord1d, &args ))) WARN( "glTexCoord1d returned %#lx\n", status );
+    queue_gl_call( unix_glTexCoord1d, &args, sizeof(args) );
 }
 
 void WINAPI glTexCoord1dv( const GLdouble *v )
@@ -2153,9 +2124,8 @@ void WINAPI glTexCoord1dv( const GLdouble *v )
 void WINAPI glTexCoord1f( GLfloat s )
 {
     struct glTexCoord1f_params args = { .teb = NtCurrentTeb(), .s = s };
-    NTSTATUS status;
     TRACE( "s %f\n", s );
-    if ((status = UNIX_CALL( glTexCoord1f, &args ))) WARN( "glTexCoord1f returned %#lx\n", status );
+    queue_gl_call( unix_glTexCoord1f, &args, sizeof(args) );
 }
 
 void WINAPI glTexCoord1fv( const GLfloat *v )
@@ -2169,9 +2139,8 @@ void WINAPI glTexCoord1fv( const GLfloat *v )
 void WINAPI glTexCoord1i( GLint s )
 {
     struct glTexCoord1i_params args = { .teb = NtCurrentTeb(), .s = s };
-    NTSTATUS status;
     TRACE( "s %d\n", s );
-    if ((status = UNIX_CALL( glTexCoord1i, &args ))) WARN( "glTexCoord1i returned %#lx\n", status );
+    queue_gl_call( unix_glTexCoord1i, &args, sizeof(args) );
 }
 
 void WINAPI glTexCoord1iv( const GLint *v )
@@ -2185,9 +2154,8 @@ void WINAPI glTexCoord1iv( const GLint *v )
 void WINAPI glTexCoord1s( GLshort s )
 {
     struct glTexCoord1s_params args = { .teb = NtCurrentTeb(), .s = s };
-    NTSTATUS status;
     TRACE( "s %d\n", s );
-    if ((status = UNIX_CALL( glTexCoord1s, &args ))) WARN( "glTexCoord1s returned %#lx\n", status );
+    queue_gl_call( unix_glTexCoord1s, &args, sizeof(args) );
 }
 
 void WINAPI glTexCoord1sv( const GLshort *v )
@@ -2201,9 +2169,8 @@ void WINAPI glTexCoord1sv( const GLshort *v )
 void WINAPI glTexCoord2d( GLdouble s, GLdouble t )
 {
     struct glTexCoord2d_params args = { .teb = NtCurrentTeb(), .s = s, .t = t };
-    NTSTATUS status;
     TRACE( "s %f, t %f\n", s, t );
-    if ((status = UNIX_CALL( glTexCoord2d, &args ))) WARN( "glTexCoord2d returned %#lx\n", status );
+    queue_gl_call( unix_glTexCoord2d, &args, sizeof(args) );
 }
 
 void WINAPI glTexCoord2dv( const GLdouble *v )
@@ -2217,9 +2184,8 @@ void WINAPI glTexCoord2dv( const GLdouble *v )
 void WINAPI glTexCoord2f( GLfloat s, GLfloat t )
 {
     struct glTexCoord2f_params args = { .teb = NtCurrentTeb(), .s = s, .t = t };
-    NTSTATUS status;
     TRACE( "s %f, t %f\n", s, t );
-    if ((status = UNIX_CALL( glTexCoord2f, &args ))) WARN( "glTexCoord2f returned %#lx\n", status );
+    queue_gl_call( unix_glTexCoord2f, &args, sizeof(args) );
 }
 
 void WINAPI glTexCoord2fv( const GLfloat *v )
@@ -2233,9 +2199,8 @@ void WINAPI glTexCoord2fv( const GLfloat *v )
 void WINAPI glTexCoord2i( GLint s, GLint t )
 {
     struct glTexCoord2i_params args = { .teb = NtCurrentTeb(), .s = s, .t = t };
-    NTSTATUS status;
     TRACE( "s %d, t %d\n", s, t );
-    if ((status = UNIX_CALL( glTexCoord2i, &args ))) WARN( "glTexCoord2i returned %#lx\n", status );
+    queue_gl_call( unix_glTexCoord2i, &args, sizeof(args) );
 }
 
 void WINAPI glTexCoord2iv( const GLint *v )
@@ -2249,9 +2214,8 @@ void WINAPI glTexCoord2iv( const GLint *v )
 void WINAPI glTexCoord2s( GLshort s, GLshort t )
 {
     struct glTexCoord2s_params args = { .teb = NtCurrentTeb(), .s = s, .t = t };
-    NTSTATUS status;
     TRACE( "s %d, t %d\n", s, t );
-    if ((status = UNIX_CALL( glTexCoord2s, &args ))) WARN( "glTexCoord2s returned %#lx\n", status );
+    queue_gl_call( unix_glTexCoord2s, &args, sizeof(args) );
 }
 
 void WINAPI glTexCoord2sv( const GLshort *v )
@@ -2265,9 +2229,8 @@ void WINAPI glTexCoord2sv( const GLshort *v )
 void WINAPI glTexCoord3d( GLdouble s, GLdouble t, GLdouble r )
 {
     struct glTexCoord3d_params args = { .teb = NtCurrentTeb(), .s = s, .t = t, .r = r };
-    NTSTATUS status;
     TRACE( "s %f, t %f, r %f\n", s, t, r );
-    if ((status = UNIX_CALL( glTexCoord3d, &args ))) WARN( "glTexCoord3d returned %#lx\n", status );
+    queue_gl_call( unix_glTexCoord3d, &args, sizeof(args) );
 }
 
 void WINAPI glTexCoord3dv( const GLdouble *v )
@@ -2281,9 +2244,8 @@ void WINAPI glTexCoord3dv( const GLdouble *v )
 void WINAPI glTexCoord3f( GLfloat s, GLfloat t, GLfloat r )
 {
     struct glTexCoord3f_params args = { .teb = NtCurrentTeb(), .s = s, .t = t, .r = r };
-    NTSTATUS status;
     TRACE( "s %f, t %f, r %f\n", s, t, r );
-    if ((status = UNIX_CALL( glTexCoord3f, &args ))) WARN( "glTexCoord3f returned %#lx\n", status );
+    queue_gl_call( unix_glTexCoord3f, &args, sizeof(args) );
 }
 
 void WINAPI glTexCoord3fv( const GLfloat *v )
@@ -2297,9 +2259,8 @@ void WINAPI glTexCoord3fv( const GLfloat *v )
 void WINAPI glTexCoord3i( GLint s, GLint t, GLint r )
 {
     struct glTexCoord3i_params args = { .teb = NtCurrentTeb(), .s = s, .t = t, .r = r };
-    NTSTATUS status;
     TRACE( "s %d, t %d, r %d\n", s, t, r );
-    if ((status = UNIX_CALL( glTexCoord3i, &args ))) WARN( "glTexCoord3i returned %#lx\n", status );
+    queue_gl_call( unix_glTexCoord3i, &args, sizeof(args) );
 }
 
 void WINAPI glTexCoord3iv( const GLint *v )
@@ -2313,9 +2274,8 @@ void WINAPI glTexCoord3iv( const GLint *v )
 void WINAPI glTexCoord3s( GLshort s, GLshort t, GLshort r )
 {
     struct glTexCoord3s_params args = { .teb = NtCurrentTeb(), .s = s, .t = t, .r = r };
-    NTSTATUS status;
     TRACE( "s %d, t %d, r %d\n", s, t, r );
-    if ((status = UNIX_CALL( glTexCoord3s, &args ))) WARN( "glTexCoord3s returned %#lx\n", status );
+    queue_gl_call( unix_glTexCoord3s, &args, sizeof(args) );
 }
 
 void WINAPI glTexCoord3sv( const GLshort *v )
@@ -2329,9 +2289,8 @@ void WINAPI glTexCoord3sv( const GLshort *v )
 void WINAPI glTexCoord4d( GLdouble s, GLdouble t, GLdouble r, GLdouble q )
 {
     struct glTexCoord4d_params args = { .teb = NtCurrentTeb(), .s = s, .t = t, .r = r, .q = q };
-    NTSTATUS status;
     TRACE( "s %f, t %f, r %f, q %f\n", s, t, r, q );
-    if ((status = UNIX_CALL( glTexCoord4d, &args ))) WARN( "glTexCoord4d returned %#lx\n", status );
+    queue_gl_call( unix_glTexCoord4d, &args, sizeof(args) );
 }
 
 void WINAPI glTexCoord4dv( const GLdouble *v )
@@ -2345,9 +2304,8 @@ void WINAPI glTexCoord4dv( const GLdouble *v )
 void WINAPI glTexCoord4f( GLfloat s, GLfloat t, GLfloat r, GLfloat q )
 {
     struct glTexCoord4f_params args = { .teb = NtCurrentTeb(), .s = s, .t = t, .r = r, .q = q };
-    NTSTATUS status;
     TRACE( "s %f, t %f, r %f, q %f\n", s, t, r, q );
-    if ((status = UNIX_CALL( glTexCoord4f, &args ))) WARN( "glTexCoord4f returned %#lx\n", status );
+    queue_gl_call( unix_glTexCoord4f, &args, sizeof(args) );
 }
 
 void WINAPI glTexCoord4fv( const GLfloat *v )
@@ -2361,9 +2319,8 @@ void WINAPI glTexCoord4fv( const GLfloat *v )
 void WINAPI glTexCoord4i( GLint s, GLint t, GLint r, GLint q )
 {
     struct glTexCoord4i_params args = { .teb = NtCurrentTeb(), .s = s, .t = t, .r = r, .q = q };
-    NTSTATUS status;
     TRACE( "s %d, t %d, r %d, q %d\n", s, t, r, q );
-    if ((status = UNIX_CALL( glTexCoord4i, &args ))) WARN( "glTexCoord4i returned %#lx\n", status );
+    queue_gl_call( unix_glTexCoord4i, &args, sizeof(args) );
 }
 
 void WINAPI glTexCoord4iv( const GLint *v )
@@ -2377,9 +2334,8 @@ void WINAPI glTexCoord4iv( const GLint *v )
 void WINAPI glTexCoord4s( GLshort s, GLshort t, GLshort r, GLshort q )
 {
     struct glTexCoord4s_params args = { .teb = NtCurrentTeb(), .s = s, .t = t, .r = r, .q = q };
-    NTSTATUS status;
     TRACE( "s %d, t %d, r %d, q %d\n", s, t, r, q );
-    if ((status = UNIX_CALL( glTexCoord4s, &args ))) WARN( "glTexCoord4s returned %#lx\n", status );
+    queue_gl_call( unix_glTexCoord4s, &args, sizeof(args) );
 }
 
 void WINAPI glTexCoord4sv( const GLshort *v )
@@ -2561,9 +2517,8 @@ void WINAPI glTranslatef( GLfloat x, GLfloat y, GLfloat z )
 void WINAPI glVertex2d( GLdouble x, GLdouble y )
 {
     struct glVertex2d_params args = { .teb = NtCurrentTeb(), .x = x, .y = y };
-    NTSTATUS status;
     TRACE( "x %f, y %f\n", x, y );
-    if ((status = UNIX_CALL( glVertex2d, &args ))) WARN( "glVertex2d returned %#lx\n", status );
+    queue_gl_call( unix_glVertex2d, &args, sizeof(args) );
 }
 
 void WINAPI glVertex2dv( const GLdouble *v )
@@ -2577,9 +2532,8 @@ void WINAPI glVertex2dv( const GLdouble *v )
 void WINAPI glVertex2f( GLfloat x, GLfloat y )
 {
     struct glVertex2f_params args = { .teb = NtCurrentTeb(), .x = x, .y = y };
-    NTSTATUS status;
     TRACE( "x %f, y %f\n", x, y );
-    if ((status = UNIX_CALL( glVertex2f, &args ))) WARN( "glVertex2f returned %#lx\n", status );
+    queue_gl_call( unix_glVertex2f, &args, sizeof(args) );
 }
 
 void WINAPI glVertex2fv( const GLfloat *v )
@@ -2593,9 +2547,8 @@ void WINAPI glVertex2fv( const GLfloat *v )
 void WINAPI glVertex2i( GLint x, GLint y )
 {
     struct glVertex2i_params args = { .teb = NtCurrentTeb(), .x = x, .y = y };
-    NTSTATUS status;
     TRACE( "x %d, y %d\n", x, y );
-    if ((status = UNIX_CALL( glVertex2i, &args ))) WARN( "glVertex2i returned %#lx\n", status );
+    queue_gl_call( unix_glVertex2i, &args, sizeof(args) );
 }
 
 void WINAPI glVertex2iv( const GLint *v )
@@ -2609,9 +2562,8 @@ void WINAPI glVertex2iv( const GLint *v )
 void WINAPI glVertex2s( GLshort x, GLshort y )
 {
     struct glVertex2s_params args = { .teb = NtCurrentTeb(), .x = x, .y = y };
-    NTSTATUS status;
     TRACE( "x %d, y %d\n", x, y );
-    if ((status = UNIX_CALL( glVertex2s, &args ))) WARN( "glVertex2s returned %#lx\n", status );
+    queue_gl_call( unix_glVertex2s, &args, sizeof(args) );
 }
 
 void WINAPI glVertex2sv( const GLshort *v )
@@ -2625,9 +2577,8 @@ void WINAPI glVertex2sv( const GLshort *v )
 void WINAPI glVertex3d( GLdouble x, GLdouble y, GLdouble z )
 {
     struct glVertex3d_params args = { .teb = NtCurrentTeb(), .x = x, .y = y, .z = z };
-    NTSTATUS status;
     TRACE( "x %f, y %f, z %f\n", x, y, z );
-    if ((status = UNIX_CALL( glVertex3d, &args ))) WARN( "glVertex3d returned %#lx\n", status );
+    queue_gl_call( unix_glVertex3d, &args, sizeof(args) );
 }
 
 void WINAPI glVertex3dv( const GLdouble *v )
@@ -2641,9 +2592,8 @@ void WINAPI glVertex3dv( const GLdouble *v )
 void WINAPI glVertex3f( GLfloat x, GLfloat y, GLfloat z )
 {
     struct glVertex3f_params args = { .teb = NtCurrentTeb(), .x = x, .y = y, .z = z };
-    NTSTATUS status;
     TRACE( "x %f, y %f, z %f\n", x, y, z );
-    if ((status = UNIX_CALL( glVertex3f, &args ))) WARN( "glVertex3f returned %#lx\n", status );
+    queue_gl_call( unix_glVertex3f, &args, sizeof(args) );
 }
 
 void WINAPI glVertex3fv( const GLfloat *v )
@@ -2657,9 +2607,8 @@ void WINAPI glVertex3fv( const GLfloat *v )
 void WINAPI glVertex3i( GLint x, GLint y, GLint z )
 {
     struct glVertex3i_params args = { .teb = NtCurrentTeb(), .x = x, .y = y, .z = z };
-    NTSTATUS status;
     TRACE( "x %d, y %d, z %d\n", x, y, z );
-    if ((status = UNIX_CALL( glVertex3i, &args ))) WARN( "glVertex3i returned %#lx\n", status );
+    queue_gl_call( unix_glVertex3i, &args, sizeof(args) );
 }
 
 void WINAPI glVertex3iv( const GLint *v )
@@ -2673,9 +2622,8 @@ void WINAPI glVertex3iv( const GLint *v )
 void WINAPI glVertex3s( GLshort x, GLshort y, GLshort z )
 {
     struct glVertex3s_params args = { .teb = NtCurrentTeb(), .x = x, .y = y, .z = z };
-    NTSTATUS status;
     TRACE( "x %d, y %d, z %d\n", x, y, z );
-    if ((status = UNIX_CALL( glVertex3s, &args ))) WARN( "glVertex3s returned %#lx\n", status );
+    queue_gl_call( unix_glVertex3s, &args, sizeof(args) );
 }
 
 void WINAPI glVertex3sv( const GLshort *v )
@@ -2689,9 +2637,8 @@ void WINAPI glVertex3sv( const GLshort *v )
 void WINAPI glVertex4d( GLdouble x, GLdouble y, GLdouble z, GLdouble w )
 {
     struct glVertex4d_params args = { .teb = NtCurrentTeb(), .x = x, .y = y, .z = z, .w = w };
-    NTSTATUS status;
     TRACE( "x %f, y %f, z %f, w %f\n", x, y, z, w );
-    if ((status = UNIX_CALL( glVertex4d, &args ))) WARN( "glVertex4d returned %#lx\n", status );
+    queue_gl_call( unix_glVertex4d, &args, sizeof(args) );
 }
 
 void WINAPI glVertex4dv( const GLdouble *v )
@@ -2705,9 +2652,8 @@ void WINAPI glVertex4dv( const GLdouble *v )
 void WINAPI glVertex4f( GLfloat x, GLfloat y, GLfloat z, GLfloat w )
 {
     struct glVertex4f_params args = { .teb = NtCurrentTeb(), .x = x, .y = y, .z = z, .w = w };
-    NTSTATUS status;
     TRACE( "x %f, y %f, z %f, w %f\n", x, y, z, w );
-    if ((status = UNIX_CALL( glVertex4f, &args ))) WARN( "glVertex4f returned %#lx\n", status );
+    queue_gl_call( unix_glVertex4f, &args, sizeof(args) );
 }
 
 void WINAPI glVertex4fv( const GLfloat *v )
@@ -2721,9 +2667,8 @@ void WINAPI glVertex4fv( const GLfloat *v )
 void WINAPI glVertex4i( GLint x, GLint y, GLint z, GLint w )
 {
     struct glVertex4i_params args = { .teb = NtCurrentTeb(), .x = x, .y = y, .z = z, .w = w };
-    NTSTATUS status;
     TRACE( "x %d, y %d, z %d, w %d\n", x, y, z, w );
-    if ((status = UNIX_CALL( glVertex4i, &args ))) WARN( "glVertex4i returned %#lx\n", status );
+    queue_gl_call( unix_glVertex4i, &args, sizeof(args) );
 }
 
 void WINAPI glVertex4iv( const GLint *v )
@@ -2737,9 +2682,8 @@ void WINAPI glVertex4iv( const GLint *v )
 void WINAPI glVertex4s( GLshort x, GLshort y, GLshort z, GLshort w )
 {
     struct glVertex4s_params args = { .teb = NtCurrentTeb(), .x = x, .y = y, .z = z, .w = w };
-    NTSTATUS status;
     TRACE( "x %d, y %d, z %d, w %d\n", x, y, z, w );
-    if ((status = UNIX_CALL( glVertex4s, &args ))) WARN( "glVertex4s returned %#lx\n", status );
+    queue_gl_call( unix_glVertex4s, &args, sizeof(args) );
 }
 
 void WINAPI glVertex4sv( const GLshort *v )
@@ -43,6 +43,11 @@ extern const int extension_registry_size DECLSPEC_HIDDEN;
 
 extern struct opengl_funcs null_opengl_funcs DECLSPEC_HIDDEN;
 
+extern const unixlib_entry_t __wine_unix_call_funcs[];
+#ifdef _WIN64
+extern const unixlib_entry_t __wine_unix_call_wow64_funcs[];
+#endif
+
 static inline struct opengl_funcs *get_dc_funcs( HDC hdc )
 {
     struct opengl_funcs *funcs = __wine_get_wgl_driver( hdc, WINE_WGL_DRIVER_VERSION );
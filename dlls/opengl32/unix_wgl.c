@@ -1064,6 +1064,21 @@ NTSTATUS process_detach( void *args )
     return STATUS_SUCCESS;
 }
 
+NTSTATUS call_batch( void *args )
+{
+    struct call_batch_params *params = args;
+    const BYTE *ptr = params->data, *end = ptr + params->size;
+
+    while (ptr < end)
+    {
+        const struct batch_entry *entry = (const struct batch_entry *)ptr;
+        __wine_unix_call_funcs[entry->code]( (void *)(entry + 1) );
+        ptr += entry->size;
+    }
+
+    return STATUS_SUCCESS;
+}
+
 #ifdef _WIN64
 
 typedef ULONG PTR32;
@@ -2101,6 +2116,25 @@ NTSTATUS wow64_thread_attach( void *args )
     return thread_attach( get_teb64( (ULONG_PTR)args ));
 }
 
+NTSTATUS wow64_call_batch( void *args )
+{
+    struct
+    {
+        PTR32 data;
+        UINT size;
+    } *params32 = args;
+    const BYTE *ptr = ULongToPtr(params32->data), *end = ptr + params32->size;
+
+    while (ptr < end)
+    {
+        const struct batch_entry *entry = (const struct batch_entry *)ptr;
+        __wine_unix_call_wow64_funcs[entry->code]( (void *)(entry + 1) );
+        ptr += entry->size;
+    }
+
+    return STATUS_SUCCESS;
+}
+
 NTSTATUS wow64_process_detach( void *args )
 {
     NTSTATUS status;
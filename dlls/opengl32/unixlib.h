@@ -25335,6 +25335,7 @@ enum unix_funcs
 {
     unix_thread_attach,
     unix_process_detach,
+    unix_call_batch,
     unix_wglCopyContext,
     unix_wglCreateContext,
     unix_wglDeleteContext,
@@ -28391,6 +28392,18 @@ struct wine_gl_debug_message_params
     const GLchar *message;
 };
 
-#define UNIX_CALL( func, params ) WINE_UNIX_CALL( unix_ ## func, params )
+struct call_batch_params
+{
+    const void *data;
+    UINT size;
+};
+
+struct batch_entry
+{
+    UINT code;
+    UINT size;
+};
+
+#define UNIX_CALL( func, params ) gl_unix_call( unix_ ## func, params )
 
 #endif /* __WINE_OPENGL32_UNIXLIB_H */
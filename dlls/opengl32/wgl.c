@@ -1070,13 +1070,13 @@ static void *gl_map_buffer( enum unix_funcs code, GLenum target, GLenum access )
 
     TRACE( "target %d, access %d\n", target, access );
 
-    if (!(status = WINE_UNIX_CALL( code, &args ))) return args.ret;
+    if (!(status = gl_unix_call( code, &args ))) return args.ret;
 #ifndef _WIN64
     if (status == STATUS_INVALID_ADDRESS)
     {
         TRACE( "Unable to map wow64 buffer directly, using copy buffer!\n" );
         if (!(args.ret = _aligned_malloc( (size_t)args.ret, 16 ))) status = STATUS_NO_MEMORY;
-        else if (!(status = WINE_UNIX_CALL( code, &args ))) return args.ret;
+        else if (!(status = gl_unix_call( code, &args ))) return args.ret;
         _aligned_free( args.ret );
     }
 #endif
@@ -1134,13 +1134,13 @@ static void *gl_map_named_buffer( enum unix_funcs code, GLuint buffer, GLenum ac
 
     TRACE( "(%d, %d)\n", buffer, access );
 
-    if (!(status = WINE_UNIX_CALL( code, &args ))) return args.ret;
+    if (!(status = gl_unix_call( code, &args ))) return args.ret;
 #ifndef _WIN64
     if (status == STATUS_INVALID_ADDRESS)
     {
         TRACE( "Unable to map wow64 buffer directly, using copy buffer!\n" );
         if (!(args.ret = _aligned_malloc( (size_t)args.ret, 16 ))) status = STATUS_NO_MEMORY;
-        else if (!(status = WINE_UNIX_CALL( code, &args ))) return args.ret;
+        else if (!(status = gl_unix_call( code, &args ))) return args.ret;
         _aligned_free( args.ret );
     }
 #endif
@@ -1172,13 +1172,13 @@ static void *gl_map_named_buffer_range( enum unix_funcs code, GLuint buffer, GLi
 
     TRACE( "buffer %d, offset %Id, length %Id, access %d\n", buffer, offset, length, access );
 
-    if (!(status = WINE_UNIX_CALL( code, &args ))) return args.ret;
+    if (!(status = gl_unix_call( code, &args ))) return args.ret;
 #ifndef _WIN64
     if (status == STATUS_INVALID_ADDRESS)
     {
         TRACE( "Unable to map wow64 buffer directly, using copy buffer!\n" );
         if (!(args.ret = _aligned_malloc( length, 16 ))) status = STATUS_NO_MEMORY;
-        else if (!(status = WINE_UNIX_CALL( code, &args ))) return args.ret;
+        else if (!(status = gl_unix_call( code, &args ))) return args.ret;
         _aligned_free( args.ret );
     }
 #endif
@@ -1210,7 +1210,7 @@ static GLboolean gl_unmap_buffer( enum unix_funcs code, GLenum target )
 
     TRACE( "target %d\n", target );
 
-    if (!(status = WINE_UNIX_CALL( code, &args ))) return args.ret;
+    if (!(status = gl_unix_call( code, &args ))) return args.ret;
 #ifndef _WIN64
     if (status == STATUS_INVALID_ADDRESS)
     {
@@ -1247,7 +1247,7 @@ static GLboolean gl_unmap_named_buffer( enum unix_funcs code, GLuint buffer )
 
     TRACE( "buffer %d\n", buffer );
 
-    if (!(status = WINE_UNIX_CALL( code, &args ))) return args.ret;
+    if (!(status = gl_unix_call( code, &args ))) return args.ret;
 #ifndef _WIN64
     if (status == STATUS_INVALID_ADDRESS)
     {
@@ -1277,6 +1277,59 @@ static BOOL WINAPI call_opengl_debug_message_callback( struct wine_gl_debug_mess
     return TRUE;
 }
 
+void flush_gl_batch( struct gl_batch *batch )
+{
+    struct call_batch_params args = { .data = batch->data, .size = batch->size };
+    NTSTATUS status;
+
+    TRACE( "batch %p, size %u\n", batch, batch->size );
+
+    /* calls made from debug callbacks while flushing are not queued */
+    batch->flushing = TRUE;
+    if ((status = WINE_UNIX_CALL( unix_call_batch, &args ))) WARN( "call_batch returned %#lx\n", status );
+    batch->flushing = FALSE;
+    batch->size = 0;
+}
+
+void queue_gl_call( UINT code, const void *args, UINT size )
+{
+    struct gl_batch *batch = NtCurrentTeb()->glReserved2;
+    UINT entry_size = (sizeof(struct batch_entry) + size + 7) & ~7;
+    struct batch_entry *entry;
+    NTSTATUS status;
+
+    if (!batch && (batch = malloc( sizeof(*batch) )))
+    {
+        batch->size = 0;
+        batch->flushing = FALSE;
+        NtCurrentTeb()->glReserved2 = batch;
+    }
+
+    if (!batch || batch->flushing)
+    {
+        if ((status = WINE_UNIX_CALL( code, (void *)args ))) WARN( "call %#x returned %#lx\n", code, status );
+        return;
+    }
+
+    if (batch->size + entry_size > sizeof(batch->data)) flush_gl_batch( batch );
+
+    entry = (struct batch_entry *)(batch->data + batch->size);
+    entry->code = code;
+    entry->size = entry_size;
+    memcpy( entry + 1, args, size );
+    batch->size += entry_size;
+}
+
+static void free_gl_batch(void)
+{
+    struct gl_batch *batch = NtCurrentTeb()->glReserved2;
+
+    if (!batch) return;
+    if (batch->size) flush_gl_batch( batch );
+    NtCurrentTeb()->glReserved2 = NULL;
+    free( batch );
+}
+
 static char *fixup_shader( GLsizei count, const GLchar *const*string, const GLint *length )
 {
     static int needs_fixup = -1;
@@ -1399,8 +1452,13 @@ BOOL WINAPI DllMain( HINSTANCE hinst, DWORD reason, LPVOID reserved )
         }
         break;
 
+    case DLL_THREAD_DETACH:
+        free_gl_batch();
+        break;
+
     case DLL_PROCESS_DETACH:
         if (reserved) break;
+        free_gl_batch();
         UNIX_CALL( process_detach, NULL );
 #ifndef _WIN64
         cleanup_wow64_strings();
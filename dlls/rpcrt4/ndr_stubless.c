@@ -52,14 +52,92 @@ static inline BOOL is_oicf_stubdesc(const PMIDL_STUB_DESC pStubDesc)
     return pStubDesc->Version >= 0x20000;
 }
 
+/* size of base types that have the same representation in memory and on the
+ * wire, or 0 for the ones that need conversion */
+static inline ULONG simple_basetype_size(unsigned char fc)
+{
+    switch (fc)
+    {
+    case FC_BYTE:
+    case FC_CHAR:
+    case FC_SMALL:
+    case FC_USMALL:
+        return sizeof(UCHAR);
+    case FC_WCHAR:
+    case FC_SHORT:
+    case FC_USHORT:
+        return sizeof(USHORT);
+    case FC_LONG:
+    case FC_ULONG:
+    case FC_ERROR_STATUS_T:
+    case FC_ENUM32:
+    case FC_FLOAT:
+        return sizeof(ULONG);
+    case FC_DOUBLE:
+    case FC_HYPER:
+        return sizeof(ULONGLONG);
+    default:
+        return 0;
+    }
+}
+
+/* The base type helpers below are inlined versions of NdrBaseTypeBufferSize,
+ * NdrBaseTypeMarshall and NdrBaseTypeUnmarshall for the most common
+ * parameters, avoiding the dispatch through the marshalling tables. */
+static inline void simple_basetype_buffer_size(PMIDL_STUB_MESSAGE pStubMsg, ULONG size)
+{
+    ULONG len = (pStubMsg->BufferLength + size - 1) & ~(size - 1);
+
+    if (len + size < len)
+    {
+        ERR("buffer length overflow - BufferLength = %lu, size = %lu\n", pStubMsg->BufferLength, size);
+        RpcRaiseException(RPC_X_BAD_STUB_DATA);
+    }
+    pStubMsg->BufferLength = len + size;
+}
+
+static inline void simple_basetype_marshall(PMIDL_STUB_MESSAGE pStubMsg, const unsigned char *pMemory, ULONG size)
+{
+    unsigned char *buffer = (unsigned char *)(((ULONG_PTR)pStubMsg->Buffer + size - 1) & ~(ULONG_PTR)(size - 1));
+    unsigned char *end = (unsigned char *)pStubMsg->RpcMsg->Buffer + pStubMsg->BufferLength;
+
+    if (buffer + size < buffer || buffer + size > end)
+    {
+        ERR("buffer overflow - Buffer = %p, BufferEnd = %p, size = %lu\n", buffer, end, size);
+        RpcRaiseException(RPC_X_BAD_STUB_DATA);
+    }
+    memset(pStubMsg->Buffer, 0, buffer - pStubMsg->Buffer);
+    memcpy(buffer, pMemory, size);
+    pStubMsg->Buffer = buffer + size;
+}
+
+static inline void simple_basetype_unmarshall(PMIDL_STUB_MESSAGE pStubMsg, unsigned char *pMemory, ULONG size)
+{
+    unsigned char *buffer = (unsigned char *)(((ULONG_PTR)pStubMsg->Buffer + size - 1) & ~(ULONG_PTR)(size - 1));
+
+    if (buffer + size < buffer || buffer + size > pStubMsg->BufferEnd)
+    {
+        ERR("buffer overflow - Buffer = %p, BufferEnd = %p, size = %lu\n", buffer, pStubMsg->BufferEnd, size);
+        RpcRaiseException(RPC_X_BAD_STUB_DATA);
+    }
+    memcpy(pMemory, buffer, size);
+    pStubMsg->Buffer = buffer + size;
+}
+
 static inline void call_buffer_sizer(PMIDL_STUB_MESSAGE pStubMsg, unsigned char *pMemory,
                                      const NDR_PARAM_OIF *param)
 {
     PFORMAT_STRING pFormat;
     NDR_BUFFERSIZE m;
+    ULONG size;
 
     if (param->attr.IsBasetype)
     {
+        if ((size = simple_basetype_size(param->u.type_format_char)))
+        {
+            simple_basetype_buffer_size(pStubMsg, size);
+            return;
+        }
         pFormat = &param->u.type_format_char;
         if (param->attr.IsSimpleRef) pMemory = *(unsigned char **)pMemory;
     }
@@ -83,11 +161,17 @@ static inline unsigned char *call_marshaller(PMIDL_STUB_MESSAGE pStubMsg, unsign
 {
     PFORMAT_STRING pFormat;
     NDR_MARSHALL m;
+    ULONG size;
 
     if (param->attr.IsBasetype)
     {
         pFormat = &param->u.type_format_char;
         if (param->attr.IsSimpleRef) pMemory = *(unsigned char **)pMemory;
+        if ((size = simple_basetype_size(*pFormat)))
+        {
+            simple_basetype_marshall(pStubMsg, pMemory, size);
+            return NULL;
+        }
     }
     else
     {
@@ -110,11 +194,18 @@ static inline unsigned char *call_unmarshaller(PMIDL_STUB_MESSAGE pStubMsg, unsi
 {
     PFORMAT_STRING pFormat;
     NDR_UNMARSHALL m;
+    ULONG size;
 
     if (param->attr.IsBasetype)
     {
         pFormat = &param->u.type_format_char;
         if (param->attr.IsSimpleRef) ppMemory = (unsigned char **)*ppMemory;
+        /* the server may unmarshall in place, leave that to the generic code */
+        if (pStubMsg->IsClient && !fMustAlloc && (size = simple_basetype_size(*pFormat)))
+        {
+            simple_basetype_unmarshall(pStubMsg, *ppMemory, size);
+            return NULL;
+        }
     }
     else
     {
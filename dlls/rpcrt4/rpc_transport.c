@@ -468,6 +468,85 @@ static int rpcrt4_conn_np_wait_for_incoming_data(RpcConnection *conn)
     return rpcrt4_conn_np_read(conn, NULL, 0);
 }
 
+static RPC_STATUS rpcrt4_conn_np_receive_fragment(RpcConnection *conn, RpcPktHdr **Header, void **Payload)
+{
+    unsigned char buffer[RPC_MAX_PACKET_SIZE];
+    const RpcPktCommonHdr *common_hdr = (const RpcPktCommonHdr *)buffer;
+    DWORD hdr_length, frag_len, count;
+    RPC_STATUS status;
+    int ret;
+
+    *Header = NULL;
+    *Payload = NULL;
+
+    TRACE("(%p, %p, %p)\n", conn, Header, Payload);
+
+    /* Fragments are written as a single pipe message, so unlike the default
+     * implementation we can usually get the whole fragment with one read. */
+    ret = rpcrt4_conn_np_read(conn, buffer, sizeof(buffer));
+    if (ret < (int)sizeof(*common_hdr))
+    {
+        WARN("Short read of header, %d bytes\n", ret);
+        return RPC_S_CALL_FAILED;
+    }
+    count = ret;
+
+    status = RPCRT4_ValidateCommonHeader(common_hdr);
+    if (status != RPC_S_OK)
+        return status;
+
+    hdr_length = RPCRT4_GetHeaderSize((const RpcPktHdr *)common_hdr);
+    frag_len = common_hdr->frag_len;
+    if (count > frag_len)
+    {
+        WARN("read %lu bytes for fragment of length %lu\n", count, frag_len);
+        return RPC_S_PROTOCOL_ERROR;
+    }
+
+    if (!(*Header = malloc(hdr_length)) ||
+        (frag_len > hdr_length && !(*Payload = malloc(frag_len - hdr_length))))
+    {
+        status = RPC_S_OUT_OF_RESOURCES;
+        goto fail;
+    }
+
+    memcpy(*Header, buffer, min(count, hdr_length));
+    if (count > hdr_length)
+        memcpy(*Payload, buffer + hdr_length, count - hdr_length);
+
+    /* read whatever didn't fit into the buffer */
+    if (count < hdr_length)
+    {
+        ret = rpcrt4_conn_np_read(conn, (char *)*Header + count, hdr_length - count);
+        if (ret != hdr_length - count)
+        {
+            WARN("bad header length, %d bytes, hdr_length %lu\n", ret, hdr_length);
+            status = RPC_S_CALL_FAILED;
+            goto fail;
+        }
+        count = hdr_length;
+    }
+    if (count < frag_len)
+    {
+        ret = rpcrt4_conn_np_read(conn, (char *)*Payload + count - hdr_length, frag_len - count);
+        if (ret != frag_len - count)
+        {
+            WARN("bad data length, %d/%lu\n", ret, frag_len - count);
+            status = RPC_S_CALL_FAILED;
+            goto fail;
+        }
+    }
+
+    return RPC_S_OK;
+
+fail:
+    free(*Header);
+    *Header = NULL;
+    free(*Payload);
+    *Payload = NULL;
+    return status;
+}
+
 static size_t rpcrt4_ncacn_np_get_top_of_tower(unsigned char *tower_data,
                                                const char *networkaddr,
                                                const char *endpoint)
@@ -3131,7 +3210,7 @@ static const struct connection_ops conn_protseq_list[] = {
     rpcrt4_conn_np_wait_for_incoming_data,
     rpcrt4_ncacn_np_get_top_of_tower,
     rpcrt4_ncacn_np_parse_top_of_tower,
-    NULL,
+    rpcrt4_conn_np_receive_fragment,
     RPCRT4_default_is_authorized,
     RPCRT4_default_authorize,
     RPCRT4_default_secure_packet,
@@ -3154,7 +3233,7 @@ static const struct connection_ops conn_protseq_list[] = {
     rpcrt4_conn_np_wait_for_incoming_data,
     rpcrt4_ncalrpc_get_top_of_tower,
     rpcrt4_ncalrpc_parse_top_of_tower,
-    NULL,
+    rpcrt4_conn_np_receive_fragment,
     rpcrt4_ncalrpc_is_authorized,
     rpcrt4_ncalrpc_authorize,
     rpcrt4_ncalrpc_secure_packet,
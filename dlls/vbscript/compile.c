@@ -1491,6 +1491,64 @@ static HRESULT fill_array_desc(compile_ctx_t *ctx, dim_decl_t *dim_decl, array_d
     return S_OK;
 }
 
+static BOOL lookup_local_ref(function_t *func, const WCHAR *name, int *ref)
+{
+    unsigned i;
+
+    /* The function's own name refers to its return value. */
+    if(!wcsicmp(func->name, name))
+        return FALSE;
+
+    for(i = 0; i < func->var_cnt; i++) {
+        if(!wcsicmp(func->vars[i].name, name)) {
+            *ref = i;
+            return TRUE;
+        }
+    }
+
+    for(i = 0; i < func->arg_cnt; i++) {
+        if(!wcsicmp(func->args[i].name, name)) {
+            *ref = -(int)i - 1;
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+/* Bind references to local variables and arguments to their slots, so that
+ * they don't need to be looked up by name at run time. */
+static void bind_local_refs(compile_ctx_t *ctx, function_t *func)
+{
+    instr_t *instr, *end = ctx->code->instrs + ctx->instr_cnt;
+    int ref;
+
+    for(instr = ctx->code->instrs + func->code_off; instr < end; instr++) {
+        switch(instr->op) {
+        case OP_ident:
+            if(lookup_local_ref(func, instr->arg1.bstr, &ref)) {
+                instr->op = OP_local;
+                instr->arg1.lng = ref;
+            }
+            break;
+        case OP_assign_ident:
+            if(lookup_local_ref(func, instr->arg1.bstr, &ref)) {
+                instr->op = OP_assign_local;
+                instr->arg1.lng = ref;
+            }
+            break;
+        case OP_set_ident:
+            if(lookup_local_ref(func, instr->arg1.bstr, &ref)) {
+                instr->op = OP_set_local;
+                instr->arg1.lng = ref;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
+
 static HRESULT compile_func(compile_ctx_t *ctx, statement_t *stat, function_t *func)
 {
     HRESULT hres;
@@ -1560,6 +1618,9 @@ static HRESULT compile_func(compile_ctx_t *ctx, statement_t *stat, function_t *f
         assert(i == func->var_cnt);
     }
 
+    if(func->type != FUNC_GLOBAL)
+        bind_local_refs(ctx, func);
+
     if(func->array_cnt) {
         unsigned array_id = 0;
         dim_decl_t *dim_decl;
@@ -27,6 +27,7 @@
 #include "ntgdi_private.h"
 #include "dibdrv.h"
 
+#include "wine/rbtree.h"
 #include "wine/debug.h"
 
 WINE_DEFAULT_DEBUG_CHANNEL(dib);
@@ -49,7 +50,8 @@ enum glyph_type
 
 struct cached_font
 {
-    struct list           entry;
+    struct list           entry;       /* entry in most-recently used list */
+    struct wine_rb_entry  tree_entry;  /* entry in lookup tree */
     LONG                  ref;
     DWORD                 hash;
     LOGFONTW              lf;
@@ -543,7 +545,8 @@ static DWORD font_cache_hash( struct cached_font *font )
 
 static int font_cache_cmp( const struct cached_font *p1, const struct cached_font *p2 )
 {
-    int ret = p1->hash - p2->hash;
+    int ret = 0;
+    if (p1->hash != p2->hash) ret = p1->hash > p2->hash ? 1 : -1;
     if (!ret) ret = p1->aa_flags - p2->aa_flags;
     if (!ret) ret = memcmp( &p1->xform, &p2->xform, sizeof(p1->xform) );
     if (!ret) ret = memcmp( &p1->lf, &p2->lf, FIELD_OFFSET( LOGFONTW, lfFaceName ));
@@ -551,9 +554,17 @@ static int font_cache_cmp( const struct cached_font *p1, const struct cached_fon
     return ret;
 }
 
+static int font_cache_compare( const void *key, const struct wine_rb_entry *entry )
+{
+    return font_cache_cmp( key, WINE_RB_ENTRY_VALUE( entry, const struct cached_font, tree_entry ));
+}
+
+static struct wine_rb_tree font_cache_tree = { font_cache_compare };
+
 static struct cached_font *add_cached_font( DC *dc, HFONT hfont, UINT aa_flags )
 {
     struct cached_font font, *ptr, *last_unused = NULL;
+    struct wine_rb_entry *entry;
     UINT i = 0, j, k;
 
     NtGdiExtGetObjectW( hfont, sizeof(font.lf), &font.lf );
@@ -570,14 +581,16 @@ static struct cached_font *add_cached_font( DC *dc, HFONT hfont, UINT aa_flags )
     font.hash = font_cache_hash( &font );
 
     pthread_mutex_lock( &font_cache_lock );
+    if ((entry = wine_rb_get( &font_cache_tree, &font )))
+    {
+        ptr = WINE_RB_ENTRY_VALUE( entry, struct cached_font, tree_entry );
+        InterlockedIncrement( &ptr->ref );
+        list_remove( &ptr->entry );
+        goto done;
+    }
+
     LIST_FOR_EACH_ENTRY( ptr, &font_cache, struct cached_font, entry )
     {
-        if (!font_cache_cmp( &font, ptr ))
-        {
-            InterlockedIncrement( &ptr->ref );
-            list_remove( &ptr->entry );
-            goto done;
-        }
         if (!ptr->ref)
         {
             i++;
@@ -599,6 +612,7 @@ static struct cached_font *add_cached_font( DC *dc, HFONT hfont, UINT aa_flags )
             }
         }
         list_remove( &ptr->entry );
+        wine_rb_remove( &font_cache_tree, &ptr->tree_entry );
     }
     else if (!(ptr = malloc( sizeof(*ptr) )))
     {
@@ -609,6 +623,7 @@ static struct cached_font *add_cached_font( DC *dc, HFONT hfont, UINT aa_flags )
     *ptr = font;
     ptr->ref = 1;
     memset( ptr->glyphs, 0, sizeof(ptr->glyphs) );
+    wine_rb_put( &font_cache_tree, ptr, &ptr->tree_entry );
 done:
     list_add_head( &font_cache, &ptr->entry );
     pthread_mutex_unlock( &font_cache_lock );
@@ -748,23 +763,32 @@ static struct cached_glyph *cache_glyph_bitmap( DC *dc, struct cached_font *font
     static const MAT2 identity = { {0,1}, {0,0}, {0,0}, {0,1} };
     UINT indices[3] = {0, 0, 0x20};
     int i, x, y;
-    DWORD ret, size;
+    DWORD ret, size, buffer[256];
     BYTE *dst, *src;
     int pad = 0, stride, bit_count;
     GLYPHMETRICS metrics;
     struct cached_glyph *glyph;
+    BOOL have_bits;
 
     if (flags & ETO_GLYPH_INDEX) ggo_flags |= GGO_GLYPH_INDEX;
-    indices[0] = index;
-    for (i = 0; i < ARRAY_SIZE( indices ); i++)
+
+    /* most glyphs are small enough to be retrieved along with their metrics in a single call,
+     * so that the font backend doesn't have to load them twice */
+    ret = NtGdiGetGlyphOutline( dc->hSelf, index, ggo_flags, &metrics, sizeof(buffer), buffer,
+                                &identity, FALSE );
+    if (!(have_bits = (ret && ret != GDI_ERROR)))
     {
-        index = indices[i];
-        ret = NtGdiGetGlyphOutline( dc->hSelf, index, ggo_flags, &metrics, 0, NULL,
-                                    &identity, FALSE );
-        if (ret != GDI_ERROR) break;
+        indices[0] = index;
+        for (i = 0; i < ARRAY_SIZE( indices ); i++)
+        {
+            index = indices[i];
+            ret = NtGdiGetGlyphOutline( dc->hSelf, index, ggo_flags, &metrics, 0, NULL,
+                                        &identity, FALSE );
+            if (ret != GDI_ERROR) break;
+        }
+        if (ret == GDI_ERROR) return NULL;
+        if (!ret) metrics.gmBlackBoxX = metrics.gmBlackBoxY = 0; /* empty glyph */
     }
-    if (ret == GDI_ERROR) return NULL;
-    if (!ret) metrics.gmBlackBoxX = metrics.gmBlackBoxY = 0; /* empty glyph */
 
     bit_count = get_glyph_depth( font->aa_flags );
     stride = get_dib_stride( metrics.gmBlackBoxX, bit_count );
@@ -775,14 +799,22 @@ static struct cached_glyph *cache_glyph_bitmap( DC *dc, struct cached_font *font
 
     if (bit_count == 8) pad = padding[ metrics.gmBlackBoxX % 4 ];
 
-    ret = NtGdiGetGlyphOutline( dc->hSelf, index, ggo_flags, &metrics, size, glyph->bits,
-                                &identity, FALSE );
-    if (ret == GDI_ERROR)
+    if (have_bits)
     {
-        free( glyph );
-        return NULL;
+        assert( ret <= size );
+        memcpy( glyph->bits, buffer, ret );
+    }
+    else
+    {
+        ret = NtGdiGetGlyphOutline( dc->hSelf, index, ggo_flags, &metrics, size, glyph->bits,
+                                    &identity, FALSE );
+        if (ret == GDI_ERROR)
+        {
+            free( glyph );
+            return NULL;
+        }
+        assert( ret <= size );
     }
-    assert( ret <= size );
     if (font->aa_flags == GGO_BITMAP)
     {
         for (y = metrics.gmBlackBoxY - 1; y >= 0; y--)
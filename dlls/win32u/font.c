@@ -49,6 +49,7 @@ WINE_DEFAULT_DEBUG_CHANNEL(font);
 
 static HKEY wine_fonts_key;
 static HKEY wine_fonts_cache_key;
+static HANDLE font_cache_mutex;
 HKEY hkcu_key;
 
 struct font_physdev
@@ -1259,68 +1260,231 @@ struct cached_face
     /* WCHAR                file_name[]; */
 };
 
+/* The cache contents are also stored packed into a single value of the cache key, so that
+ * processes can load them without enumerating every family and face key. The index is
+ * deleted whenever the cache is modified, and rebuilt by the next process loading it. */
+
+static const WCHAR cache_indexW[] = {'I','n','d','e','x',0};
+static BOOL cache_modified;
+
+enum cache_index_type
+{
+    CACHE_INDEX_FAMILY,  /* family name and second name */
+    CACHE_INDEX_FACE,    /* struct cached_face followed by the style name */
+    CACHE_INDEX_STRIKE,  /* struct cached_face followed by the style name */
+};
+
+struct cache_index_entry
+{
+    DWORD size;  /* total size, including padding to DWORD alignment */
+    DWORD type;
+    WCHAR data[1];
+};
+
+struct cache_index
+{
+    BYTE  *data;
+    SIZE_T size;
+    SIZE_T max;
+};
+
+static void lock_font_cache(void)
+{
+    NtWaitForSingleObject( font_cache_mutex, FALSE, NULL );
+}
+
+static void unlock_font_cache(void)
+{
+    NtReleaseMutant( font_cache_mutex, NULL );
+}
+
+static void add_cache_index_entry( struct cache_index *index, enum cache_index_type type,
+                                   const void *data, DWORD data_size, const WCHAR *str1, const WCHAR *str2 )
+{
+    DWORD len1 = lstrlenW( str1 ) + 1, len2 = lstrlenW( str2 ) + 1;
+    DWORD size = offsetof( struct cache_index_entry, data ) + data_size + (len1 + len2) * sizeof(WCHAR);
+    struct cache_index_entry *entry;
+    BYTE *ptr;
+
+    if (!index->data) return;  /* allocation failed earlier */
+
+    size = (size + sizeof(DWORD) - 1) & ~(sizeof(DWORD) - 1);
+    if (index->size + size > index->max)
+    {
+        SIZE_T new_max = max( index->max * 2, index->size + size );
+        if (!(ptr = realloc( index->data, new_max )))
+        {
+            free( index->data );
+            index->data = NULL;
+            return;
+        }
+        index->data = ptr;
+        index->max = new_max;
+    }
+
+    entry = (struct cache_index_entry *)(index->data + index->size);
+    memset( entry, 0, size );
+    entry->size = size;
+    entry->type = type;
+    ptr = (BYTE *)entry->data;
+    if (data_size) memcpy( ptr, data, data_size );
+    ptr += data_size;
+    memcpy( ptr, str1, len1 * sizeof(WCHAR) );
+    ptr += len1 * sizeof(WCHAR);
+    memcpy( ptr, str2, len2 * sizeof(WCHAR) );
+    index->size += size;
+}
+
+static struct gdi_font_face *load_cached_face( struct gdi_font_family *family, const WCHAR *style,
+                                               const struct cached_face *cached, const WCHAR *file,
+                                               BOOL scalable )
+{
+    struct gdi_font_face *face;
+
+    if (!(face = create_face( family, style, cached->full_name, file,
+                              NULL, 0, cached->index, cached->fs, cached->ntmflags, cached->version,
+                              cached->flags, scalable ? NULL : &cached->size )))
+        return NULL;
+
+    if (!scalable)
+        TRACE("Adding bitmap size h %d w %d size %d x_ppem %d y_ppem %d\n",
+              face->size.height, face->size.width, face->size.size >> 6,
+              face->size.x_ppem >> 6, face->size.y_ppem >> 6);
+
+    TRACE("fsCsb = %08x %08x/%08x %08x %08x %08x\n",
+          (int)face->fs.fsCsb[0], (int)face->fs.fsCsb[1],
+          (int)face->fs.fsUsb[0], (int)face->fs.fsUsb[1],
+          (int)face->fs.fsUsb[2], (int)face->fs.fsUsb[3]);
+    return face;
+}
+
 static void load_face_from_cache( HKEY hkey_family, struct gdi_font_family *family,
-                                  void *buffer, DWORD buffer_size, BOOL scalable )
+                                  void *buffer, DWORD buffer_size, BOOL scalable,
+                                  struct cache_index *index )
 {
     KEY_VALUE_FULL_INFORMATION *info = (KEY_VALUE_FULL_INFORMATION *)buffer;
     KEY_NODE_INFORMATION *node_info = (KEY_NODE_INFORMATION *)buffer;
-    DWORD index = 0, total_size;
+    DWORD value_index = 0, total_size;
     struct gdi_font_face *face;
     HKEY hkey_strike;
     WCHAR name[256];
     struct cached_face *cached;
+    const WCHAR *file;
 
-    while (reg_enum_value( hkey_family, index++, info,
+    while (reg_enum_value( hkey_family, value_index++, info,
                            buffer_size - sizeof(DWORD), name, sizeof(name) ))
     {
         cached = (struct cached_face *)((char *)info + info->DataOffset);
         if (info->Type == REG_BINARY && info->DataLength > sizeof(*cached))
         {
             ((DWORD *)cached)[info->DataLength / sizeof(DWORD)] = 0;
-            if ((face = create_face( family, name, cached->full_name,
-                                     cached->full_name + lstrlenW(cached->full_name) + 1,
-                                     NULL, 0, cached->index, cached->fs, cached->ntmflags, cached->version,
-                                     cached->flags, scalable ? NULL : &cached->size )))
-            {
-                if (!scalable)
-                    TRACE("Adding bitmap size h %d w %d size %d x_ppem %d y_ppem %d\n",
-                          face->size.height, face->size.width, face->size.size >> 6,
-                          face->size.x_ppem >> 6, face->size.y_ppem >> 6);
-
-                TRACE("fsCsb = %08x %08x/%08x %08x %08x %08x\n",
-                      (int)face->fs.fsCsb[0], (int)face->fs.fsCsb[1],
-                      (int)face->fs.fsUsb[0], (int)face->fs.fsUsb[1],
-                      (int)face->fs.fsUsb[2], (int)face->fs.fsUsb[3]);
-
-                release_face( face );
-            }
+            file = cached->full_name + lstrlenW(cached->full_name) + 1;
+            add_cache_index_entry( index, scalable ? CACHE_INDEX_FACE : CACHE_INDEX_STRIKE,
+                                   cached, (const char *)file - (const char *)cached, file, name );
+            if ((face = load_cached_face( family, name, cached, file, scalable ))) release_face( face );
         }
     }
 
     /* load bitmap strikes */
 
-    index = 0;
-    while (!NtEnumerateKey( hkey_family, index++, KeyNodeInformation, node_info,
+    value_index = 0;
+    while (!NtEnumerateKey( hkey_family, value_index++, KeyNodeInformation, node_info,
                             buffer_size, &total_size ))
     {
         if ((hkey_strike = reg_open_key( hkey_family, node_info->Name, node_info->NameLength )))
         {
-            load_face_from_cache( hkey_strike, family, buffer, buffer_size, FALSE );
+            load_face_from_cache( hkey_strike, family, buffer, buffer_size, FALSE, index );
             NtClose( hkey_strike );
         }
     }
 }
 
+static const WCHAR *next_index_string( const WCHAR *str, const WCHAR *end )
+{
+    while (str < end && *str) str++;
+    return str < end ? str + 1 : NULL;
+}
+
+static BOOL load_font_list_from_index(void)
+{
+    UNICODE_STRING nameW = { sizeof(cache_indexW) - sizeof(WCHAR), sizeof(cache_indexW), (WCHAR *)cache_indexW };
+    KEY_VALUE_PARTIAL_INFORMATION *info;
+    struct gdi_font_family *family = NULL;
+    struct gdi_font_face *face;
+    const struct cache_index_entry *entry;
+    const struct cached_face *cached;
+    const WCHAR *str, *str2, *end;
+    const BYTE *ptr, *data_end;
+    ULONG size;
+    NTSTATUS status;
+
+    status = NtQueryValueKey( wine_fonts_cache_key, &nameW, KeyValuePartialInformation, NULL, 0, &size );
+    if (status != STATUS_BUFFER_TOO_SMALL && status != STATUS_BUFFER_OVERFLOW) return FALSE;
+    if (!(info = malloc( size ))) return FALSE;
+    if (NtQueryValueKey( wine_fonts_cache_key, &nameW, KeyValuePartialInformation, info, size, &size ) ||
+        info->Type != REG_BINARY)
+    {
+        free( info );
+        return FALSE;
+    }
+
+    ptr = info->Data;
+    data_end = info->Data + info->DataLength;
+    while (ptr + offsetof( struct cache_index_entry, data ) <= data_end)
+    {
+        entry = (const struct cache_index_entry *)ptr;
+        if (entry->size <= offsetof( struct cache_index_entry, data ) || entry->size > data_end - ptr) break;
+        ptr += entry->size;
+        end = (const WCHAR *)ptr;
+
+        switch (entry->type)
+        {
+        case CACHE_INDEX_FAMILY:
+            if (!(str = next_index_string( entry->data, end ))) break;
+            if (!next_index_string( str, end )) break;
+            if (family) release_family( family );
+            TRACE( "loading family %s\n", debugstr_w(entry->data) );
+            family = create_family( entry->data, str );
+            break;
+
+        case CACHE_INDEX_FACE:
+        case CACHE_INDEX_STRIKE:
+            cached = (const struct cached_face *)entry->data;
+            if (!family || (const BYTE *)cached->full_name >= ptr) break;
+            if (!(str = next_index_string( cached->full_name, end ))) break;  /* file name */
+            if (!(str2 = next_index_string( str, end ))) break;  /* style name */
+            if (!next_index_string( str2, end )) break;
+            if ((face = load_cached_face( family, str2, cached, str, entry->type == CACHE_INDEX_FACE )))
+                release_face( face );
+            break;
+        }
+    }
+
+    if (family) release_family( family );
+    free( info );
+    return TRUE;
+}
+
 static void load_font_list_from_cache(void)
 {
-    WCHAR buffer[4096];
+    WCHAR buffer[4096], family_name[LF_FACESIZE];
     KEY_VALUE_PARTIAL_INFORMATION *info = (void *)buffer;
     KEY_NODE_INFORMATION *enum_info = (KEY_NODE_INFORMATION *)buffer;
     DWORD family_index = 0, total_size;
     struct gdi_font_family *family;
+    struct cache_index index;
     HKEY hkey_family;
     WCHAR *second_name = (WCHAR *)info->Data;
 
+    if (load_font_list_from_index()) return;
+
+    /* build the index while loading, other processes can't modify the cache in the meantime */
+    lock_font_cache();
+    cache_modified = FALSE;
+    index.size = 0;
+    index.max = 0x10000;
+    index.data = malloc( index.max );
+
     while (!NtEnumerateKey( wine_fonts_cache_key, family_index++, KeyNodeInformation, enum_info,
                             sizeof(buffer), &total_size ))
     {
@@ -1328,16 +1492,23 @@ static void load_font_list_from_cache(void)
                                           enum_info->NameLength )))
             continue;
         TRACE( "opened family key %s\n", debugstr_wn(enum_info->Name, enum_info->NameLength / sizeof(WCHAR)) );
+        lstrcpynW( family_name, enum_info->Name, min( enum_info->NameLength / sizeof(WCHAR) + 1, LF_FACESIZE ));
         if (!query_reg_value( hkey_family, NULL, info, sizeof(buffer) ))
             second_name[0] = 0;
 
-        family = create_family( buffer, second_name );
+        family = create_family( family_name, second_name );
+        add_cache_index_entry( &index, CACHE_INDEX_FAMILY, NULL, 0, family_name, second_name );
 
-        load_face_from_cache( hkey_family, family, buffer, sizeof(buffer), TRUE );
+        load_face_from_cache( hkey_family, family, buffer, sizeof(buffer), TRUE, &index );
 
         NtClose( hkey_family );
         release_family( family );
     }
+
+    if (index.data && !cache_modified)
+        set_reg_value( wine_fonts_cache_key, cache_indexW, REG_BINARY, index.data, index.size );
+    unlock_font_cache();
+    free( index.data );
 }
 
 static void add_face_to_cache( struct gdi_font_face *face )
@@ -1346,10 +1517,14 @@ static void add_face_to_cache( struct gdi_font_face *face )
     DWORD len, buffer[1024];
     struct cached_face *cached = (struct cached_face *)buffer;
 
+    lock_font_cache();
     if (!(hkey_family = reg_create_key( wine_fonts_cache_key, face->family->family_name,
                                         lstrlenW( face->family->family_name ) * sizeof(WCHAR),
                                         REG_OPTION_VOLATILE, NULL )))
+    {
+        unlock_font_cache();
         return;
+    }
 
     if (face->family->second_name[0])
         set_reg_value( hkey_family, NULL, REG_SZ, face->family->second_name,
@@ -1384,15 +1559,22 @@ static void add_face_to_cache( struct gdi_font_face *face )
 
     if (hkey_face != hkey_family) NtClose( hkey_face );
     NtClose( hkey_family );
+    reg_delete_value( wine_fonts_cache_key, cache_indexW );
+    cache_modified = TRUE;
+    unlock_font_cache();
 }
 
 static void remove_face_from_cache( struct gdi_font_face *face )
 {
     HKEY hkey_family, hkey;
 
+    lock_font_cache();
     if (!(hkey_family = reg_open_key( wine_fonts_cache_key, face->family->family_name,
                                       lstrlenW( face->family->family_name ) * sizeof(WCHAR) )))
+    {
+        unlock_font_cache();
         return;
+    }
 
     if (!face->scalable)
     {
@@ -1409,6 +1591,9 @@ static void remove_face_from_cache( struct gdi_font_face *face )
     else reg_delete_value( hkey_family, face->style_name );
 
     NtClose( hkey_family );
+    reg_delete_value( wine_fonts_cache_key, cache_indexW );
+    cache_modified = TRUE;
+    unlock_font_cache();
 }
 
 /* font links */
@@ -6804,7 +6989,6 @@ UINT font_init(void)
 {
     OBJECT_ATTRIBUTES attr = { sizeof(attr) };
     UNICODE_STRING name;
-    HANDLE mutex;
     DWORD disposition;
     UINT dpi = 0;
 
@@ -6833,8 +7017,8 @@ UINT font_init(void)
     name.Buffer = wine_font_mutexW;
     name.Length = name.MaximumLength = sizeof(wine_font_mutexW);
 
-    if (NtCreateMutant( &mutex, MUTEX_ALL_ACCESS, &attr, FALSE ) < 0) return dpi;
-    NtWaitForSingleObject( mutex, FALSE, NULL );
+    if (NtCreateMutant( &font_cache_mutex, MUTEX_ALL_ACCESS, &attr, FALSE ) < 0) return dpi;
+    lock_font_cache();
 
     wine_fonts_cache_key = reg_create_key( wine_fonts_key, cacheW, sizeof(cacheW),
                                            REG_OPTION_VOLATILE, &disposition );
@@ -6845,7 +7029,7 @@ UINT font_init(void)
         update_external_font_keys();
     }
 
-    NtReleaseMutant( mutex, NULL );
+    unlock_font_cache();
 
     if (disposition != REG_CREATED_NEW_KEY)
     {
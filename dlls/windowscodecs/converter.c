@@ -137,6 +137,33 @@ static inline FormatConverter *impl_from_IWICFormatConverter(IWICFormatConverter
     return CONTAINING_RECORD(iface, FormatConverter, IWICFormatConverter_iface);
 }
 
+/* Plain forward loops over separate buffers, in a form the compiler can
+ * vectorize. */
+static void convert_bgr24_to_bgra32(const BYTE *src, BYTE *dst, UINT width)
+{
+    UINT x;
+
+    for (x = 0; x < width; x++, src += 3, dst += 4)
+    {
+        dst[0] = src[0];
+        dst[1] = src[1];
+        dst[2] = src[2];
+        dst[3] = 0xff;
+    }
+}
+
+static void convert_rgb24_to_bgra32(const BYTE *src, BYTE *dst, UINT width)
+{
+    DWORD *dstpixel = (DWORD *)dst;
+    UINT x;
+
+    /* Swapping red and blue while expanding would need a byte shuffle, do it
+     * as a second pass on whole pixels instead. */
+    convert_bgr24_to_bgra32(src, dst, width);
+    for (x = 0; x < width; x++)
+        dstpixel[x] = (dstpixel[x] & 0xff00ff00) | ((dstpixel[x] >> 16) & 0xff) | ((dstpixel[x] & 0xff) << 16);
+}
+
 static HRESULT copypixels_to_32bppBGRA(struct FormatConverter *This, const WICRect *prc,
     UINT cbStride, UINT cbBufferSize, BYTE *pbBuffer, enum pixelformat source_format)
 {
@@ -616,88 +643,42 @@ static HRESULT copypixels_to_32bppBGRA(struct FormatConverter *This, const WICRe
         }
         return S_OK;
     case format_24bppBGR:
+    case format_24bppRGB:
         if (prc)
         {
-            HRESULT res;
-            INT x, y;
+            HRESULT res = S_OK;
+            WICRect rc;
+            INT y;
             BYTE *srcdata;
-            UINT srcstride, srcdatasize;
-            const BYTE *srcrow;
-            const BYTE *srcpixel;
-            BYTE *dstrow;
-            BYTE *dstpixel;
+            UINT srcstride, rows;
 
+            /* Convert a strip of rows at a time, so the temporary buffer stays
+             * small and the expansion loops work on separate buffers. */
             srcstride = 3 * prc->Width;
-            srcdatasize = srcstride * prc->Height;
+            rows = srcstride ? max(1, min((UINT)prc->Height, 0x10000 / srcstride)) : 1;
 
-            srcdata = HeapAlloc(GetProcessHeap(), 0, srcdatasize);
+            srcdata = HeapAlloc(GetProcessHeap(), 0, srcstride * rows);
             if (!srcdata) return E_OUTOFMEMORY;
 
-            res = IWICBitmapSource_CopyPixels(This->source, prc, srcstride, srcdatasize, srcdata);
+            rc.X = prc->X;
+            rc.Width = prc->Width;
 
-            if (SUCCEEDED(res))
+            for (y=0; y<prc->Height; y+=rc.Height)
             {
-                srcrow = srcdata;
-                dstrow = pbBuffer;
-                for (y=0; y<prc->Height; y++) {
-                    srcpixel=srcrow;
-                    dstpixel=dstrow;
-                    for (x=0; x<prc->Width; x++) {
-                        *dstpixel++=*srcpixel++; /* blue */
-                        *dstpixel++=*srcpixel++; /* green */
-                        *dstpixel++=*srcpixel++; /* red */
-                        *dstpixel++=255; /* alpha */
-                    }
-                    srcrow += srcstride;
-                    dstrow += cbStride;
-                }
-            }
+                INT i;
 
-            HeapFree(GetProcessHeap(), 0, srcdata);
+                rc.Y = prc->Y + y;
+                rc.Height = min(rows, (UINT)(prc->Height - y));
 
-            return res;
-        }
-        return S_OK;
-    case format_24bppRGB:
-        if (prc)
-        {
-            HRESULT res;
-            INT x, y;
-            BYTE *srcdata;
-            UINT srcstride, srcdatasize;
-            const BYTE *srcrow;
-            const BYTE *srcpixel;
-            BYTE *dstrow;
-            BYTE *dstpixel;
-            BYTE tmppixel[3];
-
-            srcstride = 3 * prc->Width;
-            srcdatasize = srcstride * prc->Height;
-
-            srcdata = HeapAlloc(GetProcessHeap(), 0, srcdatasize);
-            if (!srcdata) return E_OUTOFMEMORY;
+                res = IWICBitmapSource_CopyPixels(This->source, &rc, srcstride, srcstride * rc.Height, srcdata);
+                if (FAILED(res)) break;
 
-            res = IWICBitmapSource_CopyPixels(This->source, prc, srcstride, srcdatasize, srcdata);
-
-            if (SUCCEEDED(res))
-            {
-                srcrow = srcdata;
-                dstrow = pbBuffer;
-                for (y=0; y<prc->Height; y++) {
-                    srcpixel=srcrow;
-                    dstpixel=dstrow;
-                    for (x=0; x<prc->Width; x++) {
-                        tmppixel[0]=*srcpixel++; /* red */
-                        tmppixel[1]=*srcpixel++; /* green */
-                        tmppixel[2]=*srcpixel++; /* blue */
-
-                        *dstpixel++=tmppixel[2]; /* blue */
-                        *dstpixel++=tmppixel[1]; /* green */
-                        *dstpixel++=tmppixel[0]; /* red */
-                        *dstpixel++=255; /* alpha */
-                    }
-                    srcrow += srcstride;
-                    dstrow += cbStride;
+                for (i=0; i<rc.Height; i++)
+                {
+                    if (source_format == format_24bppRGB)
+                        convert_rgb24_to_bgra32(srcdata + srcstride * i, pbBuffer + cbStride * (y + i), prc->Width);
+                    else
+                        convert_bgr24_to_bgra32(srcdata + srcstride * i, pbBuffer + cbStride * (y + i), prc->Width);
                 }
             }
 
@@ -31,6 +31,14 @@
 
 WINE_DEFAULT_DEBUG_CHANNEL(wincodecs);
 
+/* Source pixels contributing to one destination row or column. Linear
+ * filtering blends pixel start and start+1 with weight frac/256 for the
+ * latter, box filtering averages count pixels starting from start. */
+struct scaler_axis
+{
+    UINT start, count, frac;
+};
+
 typedef struct BitmapScaler {
     IWICBitmapScaler IWICBitmapScaler_iface;
     LONG ref;
@@ -42,6 +50,9 @@ typedef struct BitmapScaler {
     UINT bpp;
     void (*fn_get_required_source_rect)(struct BitmapScaler*,UINT,UINT,WICRect*);
     void (*fn_copy_scanline)(struct BitmapScaler*,UINT,UINT,UINT,BYTE**,UINT,UINT,BYTE*);
+    struct scaler_axis *x_axis, *y_axis;
+    BOOL x_box, y_box;
+    UINT *row_acc;
     CRITICAL_SECTION lock; /* must be held when initialized */
 } BitmapScaler;
 
@@ -106,6 +117,9 @@ static ULONG WINAPI BitmapScaler_Release(IWICBitmapScaler *iface)
         This->lock.DebugInfo->Spare[0] = 0;
         DeleteCriticalSection(&This->lock);
         if (This->source) IWICBitmapSource_Release(This->source);
+        HeapFree(GetProcessHeap(), 0, This->x_axis);
+        HeapFree(GetProcessHeap(), 0, This->y_axis);
+        HeapFree(GetProcessHeap(), 0, This->row_acc);
         HeapFree(GetProcessHeap(), 0, This);
     }
 
@@ -203,6 +217,169 @@ static void NearestNeighbor_CopyScanline(BitmapScaler *This,
     }
 }
 
+static BOOL is_filterable_format(const WICPixelFormatGUID *format)
+{
+    /* Formats made of 8-bit channels only, which can be blended per byte. */
+    static const GUID *formats[] =
+    {
+        &GUID_WICPixelFormat8bppGray,
+        &GUID_WICPixelFormat8bppAlpha,
+        &GUID_WICPixelFormat24bppBGR,
+        &GUID_WICPixelFormat24bppRGB,
+        &GUID_WICPixelFormat32bppBGR,
+        &GUID_WICPixelFormat32bppBGRA,
+        &GUID_WICPixelFormat32bppPBGRA,
+        &GUID_WICPixelFormat32bppRGB,
+        &GUID_WICPixelFormat32bppRGBA,
+        &GUID_WICPixelFormat32bppPRGBA,
+    };
+    UINT i;
+
+    for (i = 0; i < ARRAY_SIZE(formats); i++)
+        if (IsEqualGUID(format, formats[i])) return TRUE;
+
+    return FALSE;
+}
+
+static struct scaler_axis *create_scaler_axis(UINT src_size, UINT dst_size, BOOL box)
+{
+    struct scaler_axis *axis;
+    UINT i;
+
+    if (!(axis = HeapAlloc(GetProcessHeap(), 0, dst_size * sizeof(*axis))))
+        return NULL;
+
+    for (i = 0; i < dst_size; i++)
+    {
+        if (box)
+        {
+            /* Only used when downscaling, so every span is at least one pixel. */
+            axis[i].start = (UINT64)i * src_size / dst_size;
+            axis[i].count = (UINT64)(i + 1) * src_size / dst_size - axis[i].start;
+            axis[i].frac = 0;
+        }
+        else
+        {
+            /* Position of the destination pixel center in source pixels, in
+             * 1/256 units, relative to the source pixel centers. */
+            INT64 pos = (2 * (INT64)i + 1) * src_size * 128 / dst_size - 128;
+
+            if (pos <= 0)
+            {
+                axis[i].start = 0;
+                axis[i].frac = 0;
+            }
+            else
+            {
+                axis[i].start = pos >> 8;
+                axis[i].frac = pos & 0xff;
+            }
+
+            if (axis[i].start >= src_size - 1)
+            {
+                axis[i].start = src_size - 1;
+                axis[i].frac = 0;
+            }
+            axis[i].count = axis[i].frac ? 2 : 1;
+        }
+    }
+
+    return axis;
+}
+
+static HRESULT init_filter(BitmapScaler *This, BOOL fant)
+{
+    /* Fant averages all the covered source pixels when downscaling, and is
+     * the same as linear filtering otherwise. */
+    This->x_box = fant && This->src_width > This->width;
+    This->y_box = fant && This->src_height > This->height;
+
+    This->x_axis = create_scaler_axis(This->src_width, This->width, This->x_box);
+    This->y_axis = create_scaler_axis(This->src_height, This->height, This->y_box);
+    This->row_acc = HeapAlloc(GetProcessHeap(), 0, This->src_width * (This->bpp / 8) * sizeof(UINT));
+
+    if (!This->x_axis || !This->y_axis || !This->row_acc)
+    {
+        HeapFree(GetProcessHeap(), 0, This->x_axis);
+        HeapFree(GetProcessHeap(), 0, This->y_axis);
+        HeapFree(GetProcessHeap(), 0, This->row_acc);
+        This->x_axis = This->y_axis = NULL;
+        This->row_acc = NULL;
+        return E_OUTOFMEMORY;
+    }
+
+    return S_OK;
+}
+
+static void Filter_GetRequiredSourceRect(BitmapScaler *This,
+    UINT x, UINT y, WICRect *src_rect)
+{
+    src_rect->X = This->x_axis[x].start;
+    src_rect->Width = This->x_axis[x].count;
+    src_rect->Y = This->y_axis[y].start;
+    src_rect->Height = This->y_axis[y].count;
+}
+
+static void Filter_CopyScanline(BitmapScaler *This,
+    UINT dst_x, UINT dst_y, UINT dst_width,
+    BYTE **src_data, UINT src_data_x, UINT src_data_y, BYTE *pbBuffer)
+{
+    const struct scaler_axis *y_axis = &This->y_axis[dst_y];
+    const struct scaler_axis *first = &This->x_axis[dst_x], *last = &This->x_axis[dst_x + dst_width - 1];
+    UINT bytesperpixel = This->bpp/8;
+    UINT offset = (first->start - src_data_x) * bytesperpixel;
+    UINT size = (last->start + last->count - first->start) * bytesperpixel;
+    BYTE **rows = src_data + (y_axis->start - src_data_y);
+    UINT *acc = This->row_acc;
+    UINT i, j, k;
+
+    /* Blend the source rows first, keeping 8 bits of fraction, so that each
+     * pass is a plain loop over a row. */
+    if (This->y_box)
+    {
+        for (j = 0; j < size; j++)
+            acc[j] = rows[0][offset + j];
+        for (k = 1; k < y_axis->count; k++)
+            for (j = 0; j < size; j++)
+                acc[j] += rows[k][offset + j];
+        for (j = 0; j < size; j++)
+            acc[j] = ((UINT64)acc[j] * 256 + y_axis->count / 2) / y_axis->count;
+    }
+    else if (y_axis->count == 1)
+    {
+        for (j = 0; j < size; j++)
+            acc[j] = rows[0][offset + j] << 8;
+    }
+    else
+    {
+        for (j = 0; j < size; j++)
+            acc[j] = rows[0][offset + j] * (256 - y_axis->frac) + rows[1][offset + j] * y_axis->frac;
+    }
+
+    for (i = 0; i < dst_width; i++)
+    {
+        const struct scaler_axis *x_axis = &This->x_axis[dst_x + i];
+        const UINT *src = acc + (x_axis->start - first->start) * bytesperpixel;
+        BYTE *dst = pbBuffer + i * bytesperpixel;
+
+        for (j = 0; j < bytesperpixel; j++)
+        {
+            if (This->x_box)
+            {
+                UINT64 sum = 0;
+
+                for (k = 0; k < x_axis->count; k++)
+                    sum += src[k * bytesperpixel + j];
+                dst[j] = (sum + (UINT64)x_axis->count * 128) / ((UINT64)x_axis->count * 256);
+            }
+            else if (x_axis->count == 1)
+                dst[j] = (src[j] + 128) >> 8;
+            else
+                dst[j] = (src[j] * (256 - x_axis->frac) + src[bytesperpixel + j] * x_axis->frac + 32768) >> 16;
+        }
+    }
+}
+
 static HRESULT WINAPI BitmapScaler_CopyPixels(IWICBitmapScaler *iface,
     const WICRect *prc, UINT cbStride, UINT cbBufferSize, BYTE *pbBuffer)
 {
@@ -214,7 +391,7 @@ static HRESULT WINAPI BitmapScaler_CopyPixels(IWICBitmapScaler *iface,
     BYTE *src_bits;
     ULONG bytesperrow;
     ULONG src_bytesperrow;
-    ULONG buffer_size;
+    UINT rows_alloc;
     UINT y;
 
     TRACE("(%p,%s,%u,%u,%p)\n", iface, debug_wic_rect(prc), cbStride, cbBufferSize, pbBuffer);
@@ -261,46 +438,97 @@ static HRESULT WINAPI BitmapScaler_CopyPixels(IWICBitmapScaler *iface,
      * bottom, and claims codecs optimize for this. Ideally, when called in this
      * way, we should avoid requesting a scanline from the source more than
      * once, by saving the data that will be useful for the next scanline after
-     * the call returns. The GetRequiredSourceRect/CopyScanline functions are
-     * designed to make it possible to do this in a generic way, but for now we
-     * just grab all the data we need in each call. */
+     * the call returns. For now we only avoid requesting source data more than
+     * once within a call: the source rows each destination row depends on are
+     * fetched as it is produced, and the rows shared with the previous
+     * destination row are kept. This keeps the temporary buffer small and
+     * avoids converting whole source rectangles when downscaling. */
 
     This->fn_get_required_source_rect(This, dest_rect.X, dest_rect.Y, &src_rect_ul);
     This->fn_get_required_source_rect(This, dest_rect.X+dest_rect.Width-1,
-        dest_rect.Y+dest_rect.Height-1, &src_rect_br);
+        dest_rect.Y, &src_rect_br);
 
     src_rect.X = src_rect_ul.X;
-    src_rect.Y = src_rect_ul.Y;
     src_rect.Width = src_rect_br.Width + src_rect_br.X - src_rect_ul.X;
-    src_rect.Height = src_rect_br.Height + src_rect_br.Y - src_rect_ul.Y;
+    src_rect.Y = src_rect.Height = 0;
 
     src_bytesperrow = (src_rect.Width * This->bpp + 7)/8;
-    buffer_size = src_bytesperrow * src_rect.Height;
+    src_rows = NULL;
+    src_bits = NULL;
+    rows_alloc = 0;
+    hr = S_OK;
 
-    src_rows = HeapAlloc(GetProcessHeap(), 0, sizeof(BYTE*) * src_rect.Height);
-    src_bits = HeapAlloc(GetProcessHeap(), 0, buffer_size);
-
-    if (!src_rows || !src_bits)
+    for (y=0; y < dest_rect.Height; y++)
     {
-        HeapFree(GetProcessHeap(), 0, src_rows);
-        HeapFree(GetProcessHeap(), 0, src_bits);
-        hr = E_OUTOFMEMORY;
-        goto end;
-    }
+        WICRect row_rect;
+        UINT i;
 
-    for (y=0; y<src_rect.Height; y++)
-        src_rows[y] = src_bits + y * src_bytesperrow;
+        This->fn_get_required_source_rect(This, dest_rect.X, dest_rect.Y+y, &src_rect_ul);
+        This->fn_get_required_source_rect(This, dest_rect.X+dest_rect.Width-1,
+            dest_rect.Y+y, &src_rect_br);
 
-    hr = IWICBitmapSource_CopyPixels(This->source, &src_rect, src_bytesperrow,
-        buffer_size, src_bits);
+        row_rect.X = src_rect.X;
+        row_rect.Width = src_rect.Width;
+        row_rect.Y = src_rect_ul.Y;
+        row_rect.Height = src_rect_br.Height + src_rect_br.Y - src_rect_ul.Y;
 
-    if (SUCCEEDED(hr))
-    {
-        for (y=0; y < dest_rect.Height; y++)
+        if (src_bits && row_rect.Y >= src_rect.Y && row_rect.Y < src_rect.Y + src_rect.Height &&
+            row_rect.Y + row_rect.Height >= src_rect.Y + src_rect.Height && row_rect.Height <= rows_alloc)
         {
-            This->fn_copy_scanline(This, dest_rect.X, dest_rect.Y+y, dest_rect.Width,
-                src_rows, src_rect.X, src_rect.Y, pbBuffer + cbStride * y);
+            UINT skip = row_rect.Y - src_rect.Y, keep = src_rect.Height - skip;
+
+            /* Move the rows still needed to the front, and fetch the new ones
+             * into the buffers of the rows which were dropped. */
+            for (i=0; i<skip; i++)
+            {
+                BYTE *row = src_rows[0];
+                memmove(src_rows, src_rows + 1, sizeof(BYTE*) * (rows_alloc - 1));
+                src_rows[rows_alloc - 1] = row;
+            }
+
+            src_rect = row_rect;
+            for (i=keep; i<row_rect.Height; i++)
+            {
+                WICRect rc = {src_rect.X, src_rect.Y + i, src_rect.Width, 1};
+
+                hr = IWICBitmapSource_CopyPixels(This->source, &rc, src_bytesperrow,
+                    src_bytesperrow, src_rows[i]);
+                if (FAILED(hr))
+                    break;
+            }
+            if (FAILED(hr))
+                break;
+        }
+        else
+        {
+            if (row_rect.Height > rows_alloc)
+            {
+                HeapFree(GetProcessHeap(), 0, src_rows);
+                HeapFree(GetProcessHeap(), 0, src_bits);
+
+                rows_alloc = row_rect.Height;
+                src_rows = HeapAlloc(GetProcessHeap(), 0, sizeof(BYTE*) * rows_alloc);
+                src_bits = HeapAlloc(GetProcessHeap(), 0, src_bytesperrow * rows_alloc);
+
+                if (!src_rows || !src_bits)
+                {
+                    hr = E_OUTOFMEMORY;
+                    break;
+                }
+            }
+
+            for (i=0; i<rows_alloc; i++)
+                src_rows[i] = src_bits + i * src_bytesperrow;
+
+            src_rect = row_rect;
+            hr = IWICBitmapSource_CopyPixels(This->source, &src_rect, src_bytesperrow,
+                src_bytesperrow * src_rect.Height, src_bits);
+            if (FAILED(hr))
+                break;
         }
+
+        This->fn_copy_scanline(This, dest_rect.X, dest_rect.Y+y, dest_rect.Width,
+            src_rows, src_rect.X, src_rect.Y, pbBuffer + cbStride * y);
     }
 
     HeapFree(GetProcessHeap(), 0, src_rows);
@@ -335,7 +563,6 @@ static HRESULT WINAPI BitmapScaler_Initialize(IWICBitmapScaler *iface,
 
     This->width = uiWidth;
     This->height = uiHeight;
-    This->mode = mode;
 
     hr = IWICBitmapSource_GetSize(pISource, &This->src_width, &This->src_height);
 
@@ -347,10 +574,31 @@ static HRESULT WINAPI BitmapScaler_Initialize(IWICBitmapScaler *iface,
         hr = get_pixelformat_bpp(&src_pixelformat, &This->bpp);
     }
 
+    if (SUCCEEDED(hr) && (mode == WICBitmapInterpolationModeLinear ||
+        mode == WICBitmapInterpolationModeFant) && !is_filterable_format(&src_pixelformat))
+    {
+        FIXME("mode %i not supported for format %s, using nearest neighbor\n", mode,
+            debugstr_guid(&src_pixelformat));
+        mode = WICBitmapInterpolationModeNearestNeighbor;
+    }
+
+    This->mode = mode;
+
     if (SUCCEEDED(hr))
     {
         switch (mode)
         {
+        case WICBitmapInterpolationModeLinear:
+        case WICBitmapInterpolationModeFant:
+            hr = init_filter(This, mode == WICBitmapInterpolationModeFant);
+            if (SUCCEEDED(hr))
+            {
+                IWICBitmapSource_AddRef(pISource);
+                This->source = pISource;
+            }
+            This->fn_get_required_source_rect = Filter_GetRequiredSourceRect;
+            This->fn_copy_scanline = Filter_CopyScanline;
+            break;
         default:
             FIXME("unsupported mode %i\n", mode);
             /* fall-through */
@@ -527,6 +775,9 @@ HRESULT BitmapScaler_Create(IWICBitmapScaler **scaler)
     This->src_height = 0;
     This->mode = 0;
     This->bpp = 0;
+    This->x_axis = NULL;
+    This->y_axis = NULL;
+    This->row_acc = NULL;
     InitializeCriticalSection(&This->lock);
     This->lock.DebugInfo->Spare[0] = (DWORD_PTR)(__FILE__ ": BitmapScaler.lock");
 
@@ -1315,6 +1315,73 @@ static void test_bitmap_scaler(void)
     IWICBitmap_Release(bitmap);
 }
 
+static void test_bitmap_scaler_interpolation(void)
+{
+    static const BYTE halves[] =
+    {
+        0,0,0, 0,0,0, 255,255,255, 255,255,255,
+        0,0,0, 0,0,0, 255,255,255, 255,255,255,
+    };
+    static const BYTE ramp[] = { 0,0,0, 200,200,200 };
+    static const WICBitmapInterpolationMode modes[] =
+    {
+        WICBitmapInterpolationModeLinear,
+        WICBitmapInterpolationModeFant,
+    };
+    IWICBitmapScaler *scaler;
+    IWICBitmap *bitmap, *bitmap2;
+    BYTE buf[12];
+    HRESULT hr;
+    UINT i;
+
+    hr = IWICImagingFactory_CreateBitmapFromMemory(factory, 4, 2, &GUID_WICPixelFormat24bppBGR,
+        12, sizeof(halves), (BYTE *)halves, &bitmap);
+    ok(hr == S_OK, "Failed to create a bitmap, hr %#lx.\n", hr);
+
+    hr = IWICImagingFactory_CreateBitmapFromMemory(factory, 2, 1, &GUID_WICPixelFormat24bppBGR,
+        6, sizeof(ramp), (BYTE *)ramp, &bitmap2);
+    ok(hr == S_OK, "Failed to create a bitmap, hr %#lx.\n", hr);
+
+    for (i = 0; i < ARRAY_SIZE(modes); i++)
+    {
+        winetest_push_context("mode %d", modes[i]);
+
+        hr = IWICImagingFactory_CreateBitmapScaler(factory, &scaler);
+        ok(hr == S_OK, "Failed to create bitmap scaler, hr %#lx.\n", hr);
+        hr = IWICBitmapScaler_Initialize(scaler, (IWICBitmapSource *)bitmap, 2, 1, modes[i]);
+        ok(hr == S_OK, "Failed to initialize bitmap scaler, hr %#lx.\n", hr);
+
+        memset(buf, 0xcc, sizeof(buf));
+        hr = IWICBitmapScaler_CopyPixels(scaler, NULL, 6, 6, buf);
+        ok(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+        ok(!buf[0] && !buf[1] && !buf[2], "Unexpected pixel %02x%02x%02x.\n", buf[2], buf[1], buf[0]);
+        ok(buf[3] == 0xff && buf[4] == 0xff && buf[5] == 0xff, "Unexpected pixel %02x%02x%02x.\n",
+            buf[5], buf[4], buf[3]);
+        IWICBitmapScaler_Release(scaler);
+
+        hr = IWICImagingFactory_CreateBitmapScaler(factory, &scaler);
+        ok(hr == S_OK, "Failed to create bitmap scaler, hr %#lx.\n", hr);
+        hr = IWICBitmapScaler_Initialize(scaler, (IWICBitmapSource *)bitmap2, 4, 1, modes[i]);
+        ok(hr == S_OK, "Failed to initialize bitmap scaler, hr %#lx.\n", hr);
+
+        memset(buf, 0xcc, sizeof(buf));
+        hr = IWICBitmapScaler_CopyPixels(scaler, NULL, 12, 12, buf);
+        ok(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+        ok(buf[0] <= buf[3] && buf[3] <= buf[6] && buf[6] <= buf[9] && buf[0] < buf[9],
+            "Unexpected values %u, %u, %u, %u.\n", buf[0], buf[3], buf[6], buf[9]);
+        if (modes[i] == WICBitmapInterpolationModeLinear)
+            ok(buf[0] < buf[3] && buf[6] < buf[9], "Unexpected values %u, %u, %u, %u.\n",
+                buf[0], buf[3], buf[6], buf[9]);
+        ok(buf[3] == buf[4] && buf[3] == buf[5], "Unexpected pixel %02x%02x%02x.\n", buf[5], buf[4], buf[3]);
+        IWICBitmapScaler_Release(scaler);
+
+        winetest_pop_context();
+    }
+
+    IWICBitmap_Release(bitmap2);
+    IWICBitmap_Release(bitmap);
+}
+
 static LONG obj_refcount(void *obj)
 {
     IUnknown_AddRef((IUnknown *)obj);
@@ -1485,6 +1552,7 @@ START_TEST(bitmap)
     test_CreateBitmapFromHBITMAP();
     test_clipper();
     test_bitmap_scaler();
+    test_bitmap_scaler_interpolation();
 
     IWICImagingFactory_Release(factory);
 
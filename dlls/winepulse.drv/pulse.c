@@ -76,6 +76,7 @@ struct pulse_stream
     BYTE *local_buffer, *tmp_buffer, *peek_buffer;
     void *locked_ptr;
     BOOL please_quit, just_started, just_underran;
+    UINT32 underruns;
     pa_usec_t mmdev_period_usec;
 
     INT64 clock_lastpos, clock_written;
@@ -335,7 +336,8 @@ static void pulse_attr_update(pa_stream *s, void *user) {
 static void pulse_underflow_callback(pa_stream *s, void *userdata)
 {
     struct pulse_stream *stream = userdata;
-    WARN("%p: Underflow\n", userdata);
+    stream->underruns++;
+    WARN("%p: Underflow (%u so far)\n", userdata, stream->underruns);
     stream->just_underran = TRUE;
 }
 
@@ -1529,6 +1531,23 @@ static void pulse_read(struct pulse_stream *stream)
     }
 }
 
+/* Event-driven capture streams don't wait for the next timer tick; as soon
+ * as a period is readable it is drained and the client is signaled. */
+static void pulse_read_callback(pa_stream *s, size_t nbytes, void *userdata)
+{
+    struct pulse_stream *stream = userdata;
+    SIZE_T held_bytes = stream->held_bytes;
+
+    if (!stream->started)
+        return;
+
+    TRACE("%p: %zu bytes readable\n", stream, nbytes);
+    pulse_read(stream);
+
+    if (stream->held_bytes != held_bytes && stream->event)
+        NtSetEvent(stream->event, NULL);
+}
+
 static NTSTATUS pulse_timer_loop(void *args)
 {
     struct timer_loop_params *params = args;
@@ -1667,6 +1686,9 @@ static NTSTATUS pulse_start(void *args)
         return STATUS_SUCCESS;
     }
 
+    if ((stream->flags & AUDCLNT_STREAMFLAGS_EVENTCALLBACK) && stream->dataflow == eCapture)
+        pa_stream_set_read_callback(stream->stream, pulse_read_callback, stream);
+
     pulse_write(stream);
 
     if (pa_stream_is_corked(stream->stream))
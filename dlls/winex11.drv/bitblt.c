@@ -1080,36 +1080,24 @@ static inline BOOL image_needs_byteswap( XImage *image, BOOL is_r8g8b8, int bit_
 
 /* copy image bits with byte swapping and/or pixel mapping */
 static void copy_image_byteswap( BITMAPINFO *info, const unsigned char *src, unsigned char *dst,
-                                 int src_stride, int dst_stride, int height, BOOL byteswap,
+                                 int src_stride, int dst_stride, int width_bytes, int height, BOOL byteswap,
                                  const int *mapping, unsigned int zeropad_mask, unsigned int alpha_bits )
 {
-    int x, y, padding_pos = abs(dst_stride) / sizeof(unsigned int) - 1;
+    unsigned char *ptr = dst;
+    int x, y;
 
     if (!byteswap && !mapping)  /* simply copy */
     {
         if (src != dst)
-        {
             for (y = 0; y < height; y++, src += src_stride, dst += dst_stride)
-            {
-                memcpy( dst, src, src_stride );
-                ((unsigned int *)dst)[padding_pos] &= zeropad_mask;
-            }
-        }
-        else if (zeropad_mask != ~0u)  /* only need to clear the padding */
-        {
-            for (y = 0; y < height; y++, dst += dst_stride)
-                ((unsigned int *)dst)[padding_pos] &= zeropad_mask;
-        }
-        return;
+                memcpy( dst, src, width_bytes );
     }
-
-    switch (info->bmiHeader.biBitCount)
+    else switch (info->bmiHeader.biBitCount)
     {
     case 1:
         for (y = 0; y < height; y++, src += src_stride, dst += dst_stride)
         {
-            for (x = 0; x < src_stride; x++) dst[x] = bit_swap[src[x]];
-            ((unsigned int *)dst)[padding_pos] &= zeropad_mask;
+            for (x = 0; x < width_bytes; x++) dst[x] = bit_swap[src[x]];
         }
         break;
     case 4:
@@ -1118,23 +1106,21 @@ static void copy_image_byteswap( BITMAPINFO *info, const unsigned char *src, uns
             if (mapping)
             {
                 if (byteswap)
-                    for (x = 0; x < src_stride; x++)
+                    for (x = 0; x < width_bytes; x++)
                         dst[x] = (mapping[src[x] & 0x0f] << 4) | mapping[src[x] >> 4];
                 else
-                    for (x = 0; x < src_stride; x++)
+                    for (x = 0; x < width_bytes; x++)
                         dst[x] = mapping[src[x] & 0x0f] | (mapping[src[x] >> 4] << 4);
             }
             else
-                for (x = 0; x < src_stride; x++)
+                for (x = 0; x < width_bytes; x++)
                     dst[x] = (src[x] << 4) | (src[x] >> 4);
-            ((unsigned int *)dst)[padding_pos] &= zeropad_mask;
         }
         break;
     case 8:
         for (y = 0; y < height; y++, src += src_stride, dst += dst_stride)
         {
-            for (x = 0; x < src_stride; x++) dst[x] = mapping[src[x]];
-            ((unsigned int *)dst)[padding_pos] &= zeropad_mask;
+            for (x = 0; x < width_bytes; x++) dst[x] = mapping[src[x]];
         }
         break;
     case 16:
@@ -1142,7 +1128,6 @@ static void copy_image_byteswap( BITMAPINFO *info, const unsigned char *src, uns
         {
             for (x = 0; x < info->bmiHeader.biWidth; x++)
                 ((USHORT *)dst)[x] = RtlUshortByteSwap( ((const USHORT *)src)[x] );
-            ((unsigned int *)dst)[padding_pos] &= zeropad_mask;
         }
         break;
     case 24:
@@ -1155,7 +1140,6 @@ static void copy_image_byteswap( BITMAPINFO *info, const unsigned char *src, uns
                 dst[3 * x + 1] = src[3 * x + 1];
                 dst[3 * x + 2] = tmp;
             }
-            ((unsigned int *)dst)[padding_pos] &= zeropad_mask;
         }
         break;
     case 32:
@@ -1164,6 +1148,14 @@ static void copy_image_byteswap( BITMAPINFO *info, const unsigned char *src, uns
                 ((ULONG *)dst)[x] = RtlUlongByteSwap( ((const ULONG *)src)[x] | alpha_bits );
         break;
     }
+
+    if (zeropad_mask != ~0u)  /* clear the padding */
+    {
+        int padding_pos = abs(dst_stride) / sizeof(unsigned int) - 1;
+
+        for (y = 0; y < height; y++, ptr += dst_stride)
+            ((unsigned int *)ptr)[padding_pos] &= zeropad_mask;
+    }
 }
 
 /* copy the image bits, fixing up alignment and byte swapping as necessary */
@@ -1212,7 +1204,7 @@ DWORD copy_image_bits( BITMAPINFO *info, BOOL is_r8g8b8, XImage *image,
         width_bytes = -width_bytes;
     }
 
-    copy_image_byteswap( info, src, dst, image->bytes_per_line, width_bytes, height,
+    copy_image_byteswap( info, src, dst, image->bytes_per_line, width_bytes, image->bytes_per_line, height,
                          need_byteswap, mapping, zeropad_mask, 0 );
     return ERROR_SUCCESS;
 }
@@ -1582,6 +1574,7 @@ struct x11drv_window_surface
     COLORREF              color_key;
     HRGN                  region;
     void                 *bits;
+    UINT64               *tile_hashes;  /* hashes of the last uploaded tiles, 0 if unknown */
 #ifdef HAVE_LIBXXSHM
     XShmSegmentInfo       shminfo;
 #endif
@@ -1911,6 +1904,120 @@ static void x11drv_surface_set_region( struct window_surface *window_surface, HR
     window_surface->funcs->unlock( window_surface );
 }
 
+#define SURFACE_TILE_SIZE 64
+
+static inline int get_surface_tiles_x( struct x11drv_window_surface *surface )
+{
+    return (surface->image->width + SURFACE_TILE_SIZE - 1) / SURFACE_TILE_SIZE;
+}
+
+static inline int get_surface_tiles_y( struct x11drv_window_surface *surface )
+{
+    return (surface->image->height + SURFACE_TILE_SIZE - 1) / SURFACE_TILE_SIZE;
+}
+
+/* hash the image bits of a tile, using independent lanes so that the loop can be vectorized */
+static UINT64 hash_surface_tile( const unsigned char *ptr, int stride, int width_bytes, int height )
+{
+    static const UINT64 prime = 0x100000001b3;
+    UINT64 hash, lanes[4] = { 0xcbf29ce484222325, 0x84222325cbf29ce4, 0x9ce484222325cbf2, 0x2325cbf29ce48422 };
+    int i, y, count = width_bytes / sizeof(UINT);
+
+    for (y = 0; y < height; y++, ptr += stride)
+    {
+        const UINT *words = (const UINT *)ptr;
+
+        for (i = 0; i + 4 <= count; i += 4)
+        {
+            lanes[0] = (lanes[0] ^ words[i]) * prime;
+            lanes[1] = (lanes[1] ^ words[i + 1]) * prime;
+            lanes[2] = (lanes[2] ^ words[i + 2]) * prime;
+            lanes[3] = (lanes[3] ^ words[i + 3]) * prime;
+        }
+        for (; i < count; i++) lanes[0] = (lanes[0] ^ words[i]) * prime;
+        for (i *= sizeof(UINT); i < width_bytes; i++) lanes[1] = (lanes[1] ^ ptr[i]) * prime;
+    }
+
+    hash = lanes[0] ^ (lanes[1] << 16 | lanes[1] >> 48) ^
+           (lanes[2] << 32 | lanes[2] >> 32) ^ (lanes[3] << 48 | lanes[3] >> 16);
+    return hash ? hash : 1;  /* 0 is used for unknown tiles */
+}
+
+static void put_surface_image( struct x11drv_window_surface *surface, const RECT *rect )
+{
+#ifdef HAVE_LIBXXSHM
+    if (surface->shminfo.shmid != -1)
+        XShmPutImage( gdi_display, surface->window, surface->gc, surface->image,
+                      rect->left, rect->top,
+                      surface->header.rect.left + rect->left,
+                      surface->header.rect.top + rect->top,
+                      rect->right - rect->left, rect->bottom - rect->top, False );
+    else
+#endif
+    XPutImage( gdi_display, surface->window, surface->gc, surface->image,
+               rect->left, rect->top,
+               surface->header.rect.left + rect->left,
+               surface->header.rect.top + rect->top,
+               rect->right - rect->left, rect->bottom - rect->top );
+}
+
+/* upload the tiles of a tile aligned rectangle whose contents changed since they were last uploaded */
+static BOOL put_changed_surface_tiles( struct x11drv_window_surface *surface, const RECT *rect )
+{
+    const unsigned char *data = (const unsigned char *)surface->image->data;
+    int bpp = surface->image->bits_per_pixel, stride = surface->image->bytes_per_line;
+    int x, y, start, end, tiles_x = get_surface_tiles_x( surface );
+    BOOL put = FALSE;
+    RECT tile, run;
+    UINT64 hash;
+
+    for (y = rect->top; y < rect->bottom; y += SURFACE_TILE_SIZE)
+    {
+        SetRectEmpty( &run );
+        for (x = rect->left; x < rect->right; x += SURFACE_TILE_SIZE)
+        {
+            UINT64 *prev = surface->tile_hashes + (y / SURFACE_TILE_SIZE) * tiles_x + x / SURFACE_TILE_SIZE;
+
+            SetRect( &tile, x, y, min( x + SURFACE_TILE_SIZE, rect->right ),
+                     min( y + SURFACE_TILE_SIZE, rect->bottom ) );
+            start = x * bpp / 8;
+            end = (tile.right * bpp + 7) / 8;
+            hash = hash_surface_tile( data + y * stride + start, stride, end - start, tile.bottom - tile.top );
+
+            if (hash != *prev)
+            {
+                *prev = hash;
+                if (IsRectEmpty( &run )) run = tile;
+                else run.right = tile.right;
+                continue;
+            }
+            if (IsRectEmpty( &run )) continue;
+            put_surface_image( surface, &run );
+            SetRectEmpty( &run );
+            put = TRUE;
+        }
+        if (IsRectEmpty( &run )) continue;
+        put_surface_image( surface, &run );
+        put = TRUE;
+    }
+
+    TRACE( "%p %s %s\n", surface, wine_dbgstr_rect( rect ), put ? "uploaded" : "unchanged" );
+    return put;
+}
+
+static void invalidate_surface_tiles( struct x11drv_window_surface *surface, const RECT *rect )
+{
+    int x, y, tiles_x = get_surface_tiles_x( surface ), tiles_y = get_surface_tiles_y( surface );
+    int left = max( rect->left, 0 ) / SURFACE_TILE_SIZE;
+    int top = max( rect->top, 0 ) / SURFACE_TILE_SIZE;
+    int right = min( (rect->right + SURFACE_TILE_SIZE - 1) / SURFACE_TILE_SIZE, tiles_x );
+    int bottom = min( (rect->bottom + SURFACE_TILE_SIZE - 1) / SURFACE_TILE_SIZE, tiles_y );
+
+    for (y = top; y < bottom; y++)
+        for (x = left; x < right; x++)
+            surface->tile_hashes[y * tiles_x + x] = 0;
+}
+
 /***********************************************************************
  *           x11drv_surface_flush
  */
@@ -1920,6 +2027,7 @@ static void x11drv_surface_flush( struct window_surface *window_surface )
     unsigned char *src = surface->bits;
     unsigned char *dst = (unsigned char *)surface->image->data;
     struct bitblt_coords coords;
+    BOOL flush = FALSE;
 
     window_surface->funcs->lock( window_surface );
     coords.x = 0;
@@ -1935,14 +2043,29 @@ static void x11drv_surface_flush( struct window_surface *window_surface )
 
         if (surface->is_argb || surface->color_key != CLR_INVALID) update_surface_region( surface );
 
+        if (surface->tile_hashes)  /* extend to whole tiles, so that the hashes match what is uploaded */
+        {
+            coords.visrect.left &= ~(SURFACE_TILE_SIZE - 1);
+            coords.visrect.top &= ~(SURFACE_TILE_SIZE - 1);
+            coords.visrect.right = min( (coords.visrect.right + SURFACE_TILE_SIZE - 1) & ~(SURFACE_TILE_SIZE - 1),
+                                        coords.width );
+            coords.visrect.bottom = min( (coords.visrect.bottom + SURFACE_TILE_SIZE - 1) & ~(SURFACE_TILE_SIZE - 1),
+                                         coords.height );
+        }
+
         if (src != dst)
         {
             int map[256], *mapping = get_window_surface_mapping( surface->image->bits_per_pixel, map );
             int width_bytes = surface->image->bytes_per_line;
-
-            src += coords.visrect.top * width_bytes;
-            dst += coords.visrect.top * width_bytes;
-            copy_image_byteswap( &surface->info, src, dst, width_bytes, width_bytes,
+            int bpp = surface->info.bmiHeader.biBitCount;
+            int start = coords.visrect.left * bpp / 8, end = (coords.visrect.right * bpp + 7) / 8;
+            BITMAPINFO info = surface->info;
+
+            /* only convert the columns that are flushed */
+            info.bmiHeader.biWidth = coords.visrect.right - coords.visrect.left;
+            src += coords.visrect.top * width_bytes + start;
+            dst += coords.visrect.top * width_bytes + start;
+            copy_image_byteswap( &info, src, dst, width_bytes, width_bytes, end - start,
                                  coords.visrect.bottom - coords.visrect.top,
                                  surface->byteswap, mapping, ~0u, surface->alpha_bits );
         }
@@ -1956,26 +2079,18 @@ static void x11drv_surface_flush( struct window_surface *window_surface )
                     ptr[x] |= surface->alpha_bits;
         }
 
-#ifdef HAVE_LIBXXSHM
-        if (surface->shminfo.shmid != -1)
-            XShmPutImage( gdi_display, surface->window, surface->gc, surface->image,
-                          coords.visrect.left, coords.visrect.top,
-                          surface->header.rect.left + coords.visrect.left,
-                          surface->header.rect.top + coords.visrect.top,
-                          coords.visrect.right - coords.visrect.left,
-                          coords.visrect.bottom - coords.visrect.top, False );
+        if (surface->tile_hashes) flush = put_changed_surface_tiles( surface, &coords.visrect );
         else
-#endif
-        XPutImage( gdi_display, surface->window, surface->gc, surface->image,
-                   coords.visrect.left, coords.visrect.top,
-                   surface->header.rect.left + coords.visrect.left,
-                   surface->header.rect.top + coords.visrect.top,
-                   coords.visrect.right - coords.visrect.left,
-                   coords.visrect.bottom - coords.visrect.top );
-        XFlush( gdi_display );
+        {
+            put_surface_image( surface, &coords.visrect );
+            flush = TRUE;
+        }
     }
     reset_bounds( &surface->bounds );
     window_surface->funcs->unlock( window_surface );
+
+    /* writing the requests out may block on a slow connection, don't hold the surface lock for that */
+    if (flush) XFlush( gdi_display );
 }
 
 /***********************************************************************
@@ -2003,6 +2118,7 @@ static void x11drv_surface_destroy( struct window_surface *window_surface )
         XDestroyImage( surface->image );
     }
     if (surface->region) NtGdiDeleteObjectApp( surface->region );
+    free( surface->tile_hashes );
     free( surface );
 }
 
@@ -2075,6 +2191,11 @@ struct window_surface *create_surface( Window window, const XVisualInfo *vis, co
     }
     else surface->bits = surface->image->data;
 
+    /* tile hashes are optional, surfaces simply upload all their bounds without them */
+    if (diff_surface_updates)
+        surface->tile_hashes = calloc( get_surface_tiles_x( surface ) * get_surface_tiles_y( surface ),
+                                       sizeof(*surface->tile_hashes) );
+
     TRACE( "created %p for %lx %s bits %p-%p image %p\n", surface, window, wine_dbgstr_rect(rect),
            surface->bits, (char *)surface->bits + surface->info.bmiHeader.biSizeImage,
            surface->image->data );
@@ -2117,6 +2238,8 @@ HRGN expose_surface( struct window_surface *window_surface, const RECT *rect )
     window_surface->funcs->lock( window_surface );
     OffsetRect( &rc, -window_surface->rect.left, -window_surface->rect.top );
     add_bounds_rect( &surface->bounds, &rc );
+    /* the window contents are lost, the exposed tiles must be uploaded again */
+    if (surface->tile_hashes) invalidate_surface_tiles( surface, &rc );
     if (surface->region)
     {
         region = NtGdiCreateRectRgn( rect->left, rect->top, rect->right, rect->bottom );
@@ -72,6 +72,9 @@ struct window
     rectangle_t      client_rect;     /* client rectangle (relative to parent client area) */
     struct region   *win_region;      /* region for shaped windows (relative to window rect) */
     struct region   *update_region;   /* update region (relative to window rect) */
+    struct region   *vis_rgn;         /* cached visible region (relative to window) */
+    unsigned int     vis_rgn_flags;   /* DCX flags the cached visible region was computed for */
+    unsigned int     vis_rgn_serial;  /* window tree serial the cached visible region is valid for */
     unsigned int     style;           /* window style */
     unsigned int     ex_style;        /* window extended style */
     lparam_t         id;              /* window id */
@@ -158,6 +161,14 @@ static struct window *taskman_window;
 #define WINPTR_TOPMOST   ((struct window *)3L)
 #define WINPTR_NOTOPMOST ((struct window *)4L)
 
+/* incremented on any change that can affect window visible regions */
+static unsigned int visible_region_serial = 1;
+
+static inline void invalidate_visible_regions(void)
+{
+    if (!++visible_region_serial) visible_region_serial = 1;
+}
+
 static void window_dump( struct object *obj, int verbose )
 {
     struct window *win = (struct window *)obj;
@@ -175,10 +186,12 @@ static void window_destroy( struct object *obj )
     {
         list_remove( &win->entry );
         release_object( win->parent );
+        invalidate_visible_regions();
     }
 
     if (win->win_region) free_region( win->win_region );
     if (win->update_region) free_region( win->update_region );
+    if (win->vis_rgn) free_region( win->vis_rgn );
     if (win->class) release_class( win->class );
     free( win->text );
 
@@ -267,6 +280,7 @@ static int link_window( struct window *win, struct window *previous )
         previous = WINPTR_TOP;  /* fallback to the HWND_TOP case */
     }
 
+    invalidate_visible_regions();
     old_prev = win->is_linked ? win->entry.prev : NULL;
     list_remove( &win->entry );  /* unlink it from the previous location */
 
@@ -351,6 +365,7 @@ static int set_parent_window( struct window *win, struct window *parent )
     }
     else  /* move it to parent unlinked list */
     {
+        invalidate_visible_regions();
         list_remove( &win->entry );  /* unlink it from the previous location */
         list_add_head( &win->parent->unlinked, &win->entry );
         win->is_linked = 0;
@@ -567,6 +582,9 @@ static struct window *create_window( struct window *parent, struct window *owner
     win->last_active    = win->handle;
     win->win_region     = NULL;
     win->update_region  = NULL;
+    win->vis_rgn        = NULL;
+    win->vis_rgn_flags  = 0;
+    win->vis_rgn_serial = 0;
     win->style          = 0;
     win->ex_style       = 0;
     win->id             = 0;
@@ -1117,7 +1135,7 @@ static inline struct window *get_top_clipping_window( struct window *win )
 
 
 /* compute the visible region of a window, in window coordinates */
-static struct region *get_visible_region( struct window *win, unsigned int flags )
+static struct region *compute_visible_region( struct window *win, unsigned int flags )
 {
     struct region *tmp = NULL, *region;
     int offset_x, offset_y;
@@ -1196,6 +1214,41 @@ error:
 }
 
 
+/* get the visible region of a window, in window coordinates, reusing the last computed one if nothing changed */
+static struct region *get_visible_region( struct window *win, unsigned int flags )
+{
+    struct region *region;
+
+    flags &= DCX_PARENTCLIP | DCX_WINDOW | DCX_CLIPCHILDREN;
+
+    if (win->vis_rgn && win->vis_rgn_serial == visible_region_serial && win->vis_rgn_flags == flags)
+    {
+        if (!(region = create_empty_region())) return NULL;
+        if (copy_region( region, win->vis_rgn )) return region;
+        free_region( region );
+        return NULL;
+    }
+
+    if (!(region = compute_visible_region( win, flags ))) return NULL;
+
+    if (!win->vis_rgn) win->vis_rgn = create_empty_region();
+    if (win->vis_rgn && copy_region( win->vis_rgn, region ))
+    {
+        win->vis_rgn_flags = flags;
+        win->vis_rgn_serial = visible_region_serial;
+    }
+    else
+    {
+        /* failing to cache the region is not an error, the caller still gets a valid one */
+        clear_error();
+        if (win->vis_rgn) free_region( win->vis_rgn );
+        win->vis_rgn = NULL;
+        win->vis_rgn_serial = 0;
+    }
+    return region;
+}
+
+
 /* clip all children with a custom pixel format out of the visible region */
 static struct region *clip_pixel_format_children( struct window *parent, struct region *parent_clip,
                                                   struct region *region, int offset_x, int offset_y )
@@ -1810,6 +1863,7 @@ static void set_window_pos( struct window *win, struct window *previous,
     win->visible_rect = *visible_rect;
     win->surface_rect = *surface_rect;
     win->client_rect  = *client_rect;
+    invalidate_visible_regions();
     if (!(swp_flags & SWP_NOZORDER) && win->parent) zorder_changed |= link_window( win, previous );
     if (swp_flags & SWP_SHOWWINDOW) win->style |= WS_VISIBLE;
     else if (swp_flags & SWP_HIDEWINDOW) win->style &= ~WS_VISIBLE;
@@ -1968,6 +2022,7 @@ static void set_window_region( struct window *win, struct region *region, int re
 
     if (win->win_region) free_region( win->win_region );
     win->win_region = region;
+    invalidate_visible_regions();
 
     /* expose anything revealed by the change */
     if (old_vis_rgn && ((exposed_rgn = expose_window( win, &win->window_rect, old_vis_rgn, 0 ))))
@@ -1993,6 +2048,7 @@ void free_window_handle( struct window *win )
     {
         struct region *vis_rgn = get_visible_region( win, DCX_WINDOW );
         win->style &= ~WS_VISIBLE;
+        invalidate_visible_regions();
         if (vis_rgn)
         {
             struct region *exposed_rgn = expose_window( win, &win->window_rect, vis_rgn, 0 );
@@ -2100,6 +2156,7 @@ DECL_HANDLER(create_window)
     }
     win->style = req->style;
     win->ex_style = req->ex_style;
+    invalidate_visible_regions();
 
     reply->handle    = win->handle;
     reply->parent    = win->parent ? win->parent->handle : 0;
@@ -2271,6 +2328,7 @@ DECL_HANDLER(set_window_info)
     reply->old_id        = win->id;
     reply->old_instance  = win->instance;
     reply->old_user_data = win->user_data;
+    if (req->flags & (SET_WIN_STYLE | SET_WIN_EXSTYLE)) invalidate_visible_regions();
     if (req->flags & SET_WIN_STYLE) win->style = req->style;
     if (req->flags & SET_WIN_EXSTYLE)
     {
@@ -2810,6 +2868,7 @@ DECL_HANDLER(update_window_zorder)
         {
             list_remove( &win->entry );
             list_add_before( &ptr->entry, &win->entry );
+            invalidate_visible_regions();
         }
         break;
     }